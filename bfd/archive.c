@@ -754,6 +754,100 @@ _bfd_generic_get_elt_at_index (bfd *abfd, symindex sym_index)
   return _bfd_get_elt_at_filepos (abfd, entry->file_offset);
 }
 
+/* Entry in the hash table used to number archive members while
+   building the symdef index.  */
+
+struct ar_member_ent
+{
+  file_ptr ptr;
+  unsigned int ordinal;
+};
+
+static hashval_t
+hash_member_ent (const void *p)
+{
+  file_ptr ptr = ((const struct ar_member_ent *) p)->ptr;
+
+  return (hashval_t) (ptr ^ (ptr >> 16));
+}
+
+static int
+eq_member_ent (const void *p1, const void *p2)
+{
+  return (((const struct ar_member_ent *) p1)->ptr
+	  == ((const struct ar_member_ent *) p2)->ptr);
+}
+
+/* Give every distinct member named in the armap of ABFD an ordinal,
+   and record in bfd_ardata (ABFD)->symdef_member the ordinal of the
+   member defining each symdef.  The linker uses this to skip all the
+   symbols of a member once it has been pulled in, wherever they
+   happen to be in the armap.  The index is built once per archive.  */
+
+bfd_boolean
+_bfd_archive_index_symdefs (bfd *abfd)
+{
+  struct artdata *ardata = bfd_ardata (abfd);
+  struct ar_member_ent *ents;
+  unsigned int *symdef_member;
+  htab_t htab;
+  symindex i;
+  unsigned int count;
+  bfd_size_type amt;
+
+  if (ardata->symdef_member != NULL || ardata->symdef_count == 0)
+    return TRUE;
+
+  amt = ardata->symdef_count;
+  amt *= sizeof (*symdef_member);
+  symdef_member = (unsigned int *) bfd_alloc (abfd, amt);
+  if (symdef_member == NULL)
+    return FALSE;
+
+  amt = ardata->symdef_count;
+  amt *= sizeof (*ents);
+  ents = (struct ar_member_ent *) bfd_malloc (amt);
+  if (ents == NULL)
+    return FALSE;
+
+  htab = htab_create_alloc (ardata->symdef_count, hash_member_ent,
+			    eq_member_ent, NULL, _bfd_calloc_wrapper, free);
+  if (htab == NULL)
+    {
+      free (ents);
+      return FALSE;
+    }
+
+  count = 0;
+  for (i = 0; i < ardata->symdef_count; i++)
+    {
+      struct ar_member_ent *ent = &ents[count];
+      void **slot;
+
+      ent->ptr = ardata->symdefs[i].file_offset;
+      slot = htab_find_slot (htab, ent, INSERT);
+      if (slot == NULL)
+	{
+	  htab_delete (htab);
+	  free (ents);
+	  return FALSE;
+	}
+      if (*slot == NULL)
+	{
+	  ent->ordinal = count++;
+	  *slot = ent;
+	}
+      symdef_member[i] = ((struct ar_member_ent *) *slot)->ordinal;
+    }
+
+  htab_delete (htab);
+  free (ents);
+
+  ardata->symdef_member = symdef_member;
+  ardata->member_count = count;
+  return TRUE;
+}
+
 bfd *
 _bfd_noarchive_get_elt_at_index (bfd *abfd,
 				 symindex sym_index ATTRIBUTE_UNUSED)
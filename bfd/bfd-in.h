@@ -686,6 +686,8 @@ extern bfd_boolean bfd_elf_size_dynamic_sections
    const char * const *, struct bfd_link_info *, struct bfd_section **);
 extern bfd_boolean bfd_elf_size_dynsym_hash_dynstr
   (bfd *, struct bfd_link_info *);
+extern bfd_boolean bfd_elf_size_relative_relocs
+  (struct bfd_link_info *, bfd_boolean *);
 extern void bfd_elf_set_dt_needed_name
   (bfd *, const char *);
 extern const char *bfd_elf_get_dt_soname
@@ -693,6 +693,8 @@ extern bfd_boolean bfd_elf_size_dynamic_sections
    const char * const *, struct bfd_link_info *, struct bfd_section **);
 extern bfd_boolean bfd_elf_size_dynsym_hash_dynstr
   (bfd *, struct bfd_link_info *);
+extern bfd_boolean bfd_elf_size_relative_relocs
+  (struct bfd_link_info *, bfd_boolean *);
 extern void bfd_elf_set_dt_needed_name
   (bfd *, const char *);
 extern const char *bfd_elf_get_dt_soname
@@ -8096,6 +8098,9 @@ bfd_byte *bfd_simple_get_relocated_section_contents
 bfd_boolean bfd_get_full_section_contents
    (bfd *abfd, asection *section, bfd_byte **ptr);
 
+bfd_boolean bfd_get_full_section_contents_in_window
+   (bfd *abfd, asection *section, bfd_window *w);
+
 void bfd_cache_section_contents
    (asection *sec, void *contents);
 
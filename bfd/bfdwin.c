@@ -24,10 +24,9 @@
 #include "bfd.h"
 #include "libbfd.h"
 
-/* Currently, if USE_MMAP is undefined, none of the window stuff is
-   used.  Enabled by --with-mmap.  */
-
-#ifdef USE_MMAP
+/* The a.out symbol and string table readers only use windows when
+   USE_MMAP is defined, which is enabled by --with-mmap.  Windows are
+   always available to bfd_get_full_section_contents_in_window.  */
 
 #undef HAVE_MPROTECT /* code's not tested yet */
 
@@ -139,66 +138,63 @@ bfd_get_file_window (bfd *abfd,
       && (i->data == NULL || i->mapped == 1)
       && (abfd->flags & BFD_IN_MEMORY) == 0)
     {
-      file_ptr file_offset, offset2;
-      size_t real_size;
-      int fd;
+      void *data;
+      void *map_addr;
+      bfd_size_type map_len;
+      bfd *outer = abfd;
+      file_ptr where = offset;
+      ufile_ptr filesize;
 
-      /* Find the real file and the real offset into it.  */
-      while (abfd->my_archive != NULL
-	     && !bfd_is_thin_archive (abfd->my_archive))
+      /* If we're re-using a memory region, drop the old mapping.  */
+      if (i->data != NULL)
 	{
-	  offset += abfd->origin;
-	  abfd = abfd->my_archive;
+	  munmap (i->data, i->size);
+	  i->data = NULL;
 	}
 
-      /* Seek into the file, to ensure it is open if cacheable.  */
-      if (abfd->iostream == NULL
-	  && (abfd->iovec == NULL
-	      || abfd->iovec->bseek (abfd, offset, SEEK_SET) != 0))
-	goto free_and_fail;
-
-      fd = fileno ((FILE *) abfd->iostream);
-      /* Compute offsets and size for mmap and for the user's data.  */
-      offset2 = offset % pagesize;
-      if (offset2 < 0)
-	abort ();
-      file_offset = offset - offset2;
-      real_size = offset + size - file_offset;
-      real_size = real_size + pagesize - 1;
-      real_size -= real_size % pagesize;
-
-      /* If we're re-using a memory region, make sure it's big enough.  */
-      if (i->data != NULL && i->size < size)
+      /* Pages of a mapping that lie past the end of the file raise
+	 SIGBUS when touched, so only map what the file really holds
+	 and leave the read below to diagnose a truncated file.  */
+      while (outer->my_archive != NULL
+	     && !bfd_is_thin_archive (outer->my_archive))
 	{
-	  munmap (i->data, i->size);
-	  i->data = NULL;
+	  where += outer->origin;
+	  outer = outer->my_archive;
 	}
-      i->data = mmap (i->data, real_size,
-		      writable ? PROT_WRITE | PROT_READ : PROT_READ,
-		      (writable
-		       ? MAP_FILE | MAP_PRIVATE
-		       : MAP_FILE | MAP_SHARED),
-		      fd, file_offset);
-      if (i->data == (void *) -1)
+      filesize = bfd_get_size (outer);
+      if (filesize == 0
+	  || where < 0
+	  || (ufile_ptr) where > filesize
+	  || size > filesize - where)
+	data = (void *) -1;
+      else
+	/* Go through the iovec so that archive members, cached file
+	   descriptors and custom iovecs are all handled.  */
+	data = bfd_mmap (abfd, NULL, size,
+			 writable ? PROT_WRITE | PROT_READ : PROT_READ,
+			 (writable
+			  ? MAP_FILE | MAP_PRIVATE
+			  : MAP_FILE | MAP_SHARED),
+			 offset, &map_addr, &map_len);
+      if (data != (void *) -1)
 	{
-	  /* An error happened.  Report it, or try using malloc, or
-	     something.  */
-	  bfd_set_error (bfd_error_system_call);
-	  windowp->data = 0;
 	  if (debug_windows)
-	    fprintf (stderr, "\t\tmmap failed!\n");
-	  goto free_and_fail;
+	    fprintf (stderr, "\n\tmapped %ld at %p, data at %p\n",
+		     (long) map_len, map_addr, data);
+	  i->data = map_addr;
+	  i->size = map_len;
+	  windowp->data = data;
+	  windowp->size = size;
+	  i->mapped = 1;
+	  i->refcount = 1;
+	  windowp->i = i;
+	  return TRUE;
 	}
+
+      /* The iovec can't map this file.  Fall back to reading it.  */
       if (debug_windows)
-	fprintf (stderr, "\n\tmapped %ld at %p, offset is %ld\n",
-		 (long) real_size, i->data, (long) offset2);
-      i->size = real_size;
-      windowp->data = (bfd_byte *) i->data + offset2;
-      windowp->size = size;
-      i->mapped = 1;
-      i->refcount = 1;
-      windowp->i = i;
-      return TRUE;
+	fprintf (stderr, "\t\tmmap failed!\n");
+      i->mapped = 0;
     }
   else if (debug_windows)
     {
@@ -260,5 +256,3 @@ bfd_get_file_window (bfd *abfd,
   free (i);
   return FALSE;
 }
-
-#endif /* USE_MMAP */
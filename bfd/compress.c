@@ -34,6 +34,8 @@ decompress_contents (bfd_byte *compressed_buffer,
 {
   z_stream strm;
   int rc;
+  bfd_size_type in_left = compressed_size;
+  bfd_size_type out_left = uncompressed_size;
 
   /* It is possible the section consists of several compressed
      buffers concatenated together, so we uncompress in a loop.  */
@@ -43,25 +45,86 @@ decompress_contents (bfd_byte *compressed_buffer,
      we first zero the entire z_stream structure and then set the fields
      that we need.  */
   memset (& strm, 0, sizeof strm);
-  strm.avail_in = compressed_size;
   strm.next_in = (Bytef*) compressed_buffer;
-  strm.avail_out = uncompressed_size;
+  strm.next_out = (Bytef*) uncompressed_buffer;
 
   BFD_ASSERT (Z_OK == 0);
   rc = inflateInit (&strm);
-  while (strm.avail_in > 0 && strm.avail_out > 0)
+  while (in_left > 0 && out_left > 0)
     {
       if (rc != Z_OK)
 	break;
-      strm.next_out = ((Bytef*) uncompressed_buffer
-		       + (uncompressed_size - strm.avail_out));
-      rc = inflate (&strm, Z_FINISH);
+      /* The z_stream counts are only uInt wide, so hand very large
+	 sections to zlib in pieces.  */
+      do
+	{
+	  strm.avail_in = in_left < (uInt) -1 ? in_left : (uInt) -1;
+	  strm.avail_out = out_left < (uInt) -1 ? out_left : (uInt) -1;
+	  rc = inflate (&strm, Z_NO_FLUSH);
+	  in_left = compressed_size - ((bfd_byte *) strm.next_in
+				       - compressed_buffer);
+	  out_left = uncompressed_size - ((bfd_byte *) strm.next_out
+					  - uncompressed_buffer);
+	}
+      while (rc == Z_OK);
       if (rc != Z_STREAM_END)
 	break;
       rc = inflateReset (&strm);
     }
   rc |= inflateEnd (&strm);
-  return rc == Z_OK && strm.avail_out == 0;
+  return rc == Z_OK && out_left == 0;
+}
+
+/* Deflate UNCOMPRESSED_SIZE bytes at UNCOMPRESSED_BUFFER into at most
+   COMPRESSED_SIZE bytes at COMPRESSED_BUFFER.  Return Z_OK and store
+   the length of the zlib stream in *OUT_SIZE on success, Z_BUF_ERROR
+   if the stream does not fit, or another zlib error code.  The output
+   is the same as that of compress; stopping as soon as the buffer is
+   full means we don't deflate all of an incompressible section only
+   to throw the result away.  */
+
+static int
+compress_contents (bfd_byte *uncompressed_buffer,
+		   bfd_size_type uncompressed_size,
+		   bfd_byte *compressed_buffer,
+		   bfd_size_type compressed_size,
+		   bfd_size_type *out_size)
+{
+  z_stream strm;
+  int rc;
+  bfd_size_type in_left = uncompressed_size;
+  bfd_size_type out_left = compressed_size;
+
+  memset (& strm, 0, sizeof strm);
+  strm.next_in = (Bytef*) uncompressed_buffer;
+  strm.next_out = (Bytef*) compressed_buffer;
+
+  rc = deflateInit (&strm, Z_DEFAULT_COMPRESSION);
+  if (rc != Z_OK)
+    return rc;
+  do
+    {
+      int flush = in_left < (uInt) -1 ? Z_FINISH : Z_NO_FLUSH;
+
+      strm.avail_in = in_left < (uInt) -1 ? in_left : (uInt) -1;
+      strm.avail_out = out_left < (uInt) -1 ? out_left : (uInt) -1;
+      rc = deflate (&strm, flush);
+      in_left = uncompressed_size - ((bfd_byte *) strm.next_in
+				     - uncompressed_buffer);
+      out_left = compressed_size - ((bfd_byte *) strm.next_out
+				    - compressed_buffer);
+    }
+  while (rc == Z_OK && out_left > 0);
+  deflateEnd (&strm);
+
+  if (rc == Z_STREAM_END)
+    {
+      *out_size = compressed_size - out_left;
+      return Z_OK;
+    }
+  if (rc == Z_OK)
+    return Z_BUF_ERROR;
+  return rc;
 }
 
 /* Compress data of the size specified in @var{uncompressed_size}
@@ -77,7 +140,7 @@ bfd_compress_section_contents (bfd *abfd, sec_ptr sec,
 			       bfd_byte *uncompressed_buffer,
 			       bfd_size_type uncompressed_size)
 {
-  uLong compressed_size;
+  bfd_size_type compressed_size;
   bfd_byte *buffer;
   bfd_size_type buffer_size;
   bfd_boolean decompress;
@@ -122,27 +185,22 @@ bfd_compress_section_contents (bfd *abfd, sec_ptr sec,
 
       /* Add the header size.  */
       compressed_size = zlib_size + header_size;
-    }
-  else
-    compressed_size = compressBound (uncompressed_size) + header_size;
 
-  /* Uncompress if it leads to smaller size.  */
-  if (compressed && compressed_size > orig_uncompressed_size)
-    {
-      decompress = TRUE;
-      buffer_size = orig_uncompressed_size;
-    }
-  else
-    {
-      decompress = FALSE;
-      buffer_size = compressed_size;
-    }
-  buffer = (bfd_byte *) bfd_alloc (abfd, buffer_size);
-  if (buffer == NULL)
-    return 0;
+      /* Uncompress if it leads to smaller size.  */
+      if (compressed_size > orig_uncompressed_size)
+	{
+	  decompress = TRUE;
+	  buffer_size = orig_uncompressed_size;
+	}
+      else
+	{
+	  decompress = FALSE;
+	  buffer_size = compressed_size;
+	}
+      buffer = (bfd_byte *) bfd_alloc (abfd, buffer_size);
+      if (buffer == NULL)
+	return 0;
 
-  if (compressed)
-    {
       sec->size = orig_uncompressed_size;
       if (decompress)
 	{
@@ -172,30 +230,52 @@ bfd_compress_section_contents (bfd *abfd, sec_ptr sec,
     }
   else
     {
-      if (compress ((Bytef*) buffer + header_size,
-		    &compressed_size,
-		    (const Bytef*) uncompressed_buffer,
-		    uncompressed_size) != Z_OK)
+      bfd_byte *zlib_buffer = NULL;
+      bfd_size_type zlib_limit;
+      bfd_size_type zlib_out = 0;
+      int rc = Z_BUF_ERROR;
+
+      /* PR binutils/18087: If compression didn't make the section smaller,
+	 just keep it uncompressed.  The zlib stream must leave room for
+	 the header and still be at least a byte shorter than the input.
+	 Deflate into a temporary buffer of that size, so that only the
+	 actual output is kept on the bfd's objalloc.  */
+      if (uncompressed_size > (bfd_size_type) header_size + 1)
+	{
+	  zlib_limit = uncompressed_size - header_size - 1;
+	  zlib_buffer = (bfd_byte *) bfd_malloc (zlib_limit);
+	  if (zlib_buffer == NULL)
+	    return 0;
+	  rc = compress_contents (uncompressed_buffer, uncompressed_size,
+				  zlib_buffer, zlib_limit, &zlib_out);
+	}
+      if (rc != Z_OK && rc != Z_BUF_ERROR)
 	{
-	  bfd_release (abfd, buffer);
+	  free (zlib_buffer);
 	  bfd_set_error (bfd_error_bad_value);
 	  return 0;
 	}
 
-      compressed_size += header_size;
-      /* PR binutils/18087: If compression didn't make the section smaller,
-	 just keep it uncompressed.  */
-      if (compressed_size < uncompressed_size)
-	bfd_update_compression_header (abfd, buffer, sec);
-      else
+      if (rc != Z_OK)
 	{
 	  /* NOTE: There is a small memory leak here since
 	     uncompressed_buffer is malloced and won't be freed.  */
-	  bfd_release (abfd, buffer);
+	  free (zlib_buffer);
 	  sec->contents = uncompressed_buffer;
 	  sec->compress_status = COMPRESS_SECTION_NONE;
 	  return uncompressed_size;
 	}
+
+      compressed_size = zlib_out + header_size;
+      buffer = (bfd_byte *) bfd_alloc (abfd, compressed_size);
+      if (buffer == NULL)
+	{
+	  free (zlib_buffer);
+	  return 0;
+	}
+      bfd_update_compression_header (abfd, buffer, sec);
+      memcpy (buffer + header_size, zlib_buffer, zlib_out);
+      free (zlib_buffer);
     }
 
   free (uncompressed_buffer);
@@ -232,6 +312,7 @@ bfd_get_full_section_contents (bfd *abfd, sec_ptr sec, bfd_byte **ptr)
   bfd_boolean ret;
   bfd_size_type save_size;
   bfd_size_type save_rawsize;
+  bfd_window compressed_window;
   bfd_byte *compressed_buffer;
   unsigned int compression_header_size;
 
@@ -273,25 +354,27 @@ bfd_get_full_section_contents (bfd *abfd, sec_ptr sec, bfd_byte **ptr)
       return TRUE;
 
     case DECOMPRESS_SECTION_SIZED:
-      /* Read in the full compressed section contents.  */
-      compressed_buffer = (bfd_byte *) bfd_malloc (sec->compressed_size);
-      if (compressed_buffer == NULL)
-	return FALSE;
+      /* Get at the full compressed section contents.  These are only
+	 read by inflate, so map them rather than copying them into a
+	 buffer that is thrown away straight after.  */
+      bfd_init_window (&compressed_window);
       save_rawsize = sec->rawsize;
       save_size = sec->size;
       /* Clear rawsize, set size to compressed size and set compress_status
-	 to COMPRESS_SECTION_NONE.  If the compressed size is bigger than
-	 the uncompressed size, bfd_get_section_contents will fail.  */
+	 to COMPRESS_SECTION_NONE.  Compressed contents that run past the
+	 end of the file are not mapped; they are read instead, and the
+	 read reports the file as truncated.  */
       sec->rawsize = 0;
       sec->size = sec->compressed_size;
       sec->compress_status = COMPRESS_SECTION_NONE;
-      ret = bfd_get_section_contents (abfd, sec, compressed_buffer,
-				      0, sec->compressed_size);
+      ret = bfd_get_full_section_contents_in_window (abfd, sec,
+						     &compressed_window);
       /* Restore rawsize and size.  */
       sec->rawsize = save_rawsize;
       sec->size = save_size;
       sec->compress_status = DECOMPRESS_SECTION_SIZED;
-      if (!ret)
+      compressed_buffer = (bfd_byte *) compressed_window.data;
+      if (!ret || compressed_window.size != sec->compressed_size)
 	goto fail_compressed;
 
       if (p == NULL)
@@ -311,11 +394,11 @@ bfd_get_full_section_contents (bfd *abfd, sec_ptr sec, bfd_byte **ptr)
 	  if (p != *ptr)
 	    free (p);
 	fail_compressed:
-	  free (compressed_buffer);
+	  bfd_free_window (&compressed_window);
 	  return FALSE;
 	}
 
-      free (compressed_buffer);
+      bfd_free_window (&compressed_window);
       *ptr = p;
       return TRUE;
 
@@ -339,6 +422,97 @@ bfd_get_full_section_contents (bfd *abfd, sec_ptr sec, bfd_byte **ptr)
     }
 }
 
+/*
+FUNCTION
+	bfd_get_full_section_contents_in_window
+
+SYNOPSIS
+	bfd_boolean bfd_get_full_section_contents_in_window
+	  (bfd *abfd, asection *section, bfd_window *w);
+
+DESCRIPTION
+	Like @code{bfd_get_full_section_contents}, but make the data of
+	@var{section} available through the read-only window @var{w},
+	which must have been initialized with @code{bfd_init_window}.
+	Uncompressed contents stored in a file are mapped rather than
+	copied where the host and the file's iovec allow it, and
+	contents already held in memory are handed out directly.
+	Otherwise the contents are read, and decompressed if needed,
+	into a buffer owned by the window.
+
+	The data must not be modified, and remains valid until
+	@code{bfd_free_window} is called on @var{w}.  Return
+	@code{TRUE} on success.  If the section has no contents then
+	this function returns @code{TRUE} with an empty window.
+*/
+
+bfd_boolean
+bfd_get_full_section_contents_in_window (bfd *abfd, sec_ptr sec,
+					 bfd_window *w)
+{
+  bfd_size_type sz;
+  bfd_byte *p;
+
+  bfd_free_window (w);
+  w->size = 0;
+
+  if (abfd->direction != write_direction && sec->rawsize != 0)
+    sz = sec->rawsize;
+  else
+    sz = sec->size;
+  if (sz == 0)
+    return TRUE;
+
+  if ((sec->compress_status == COMPRESS_SECTION_DONE
+       || (sec->compress_status == COMPRESS_SECTION_NONE
+	   && (sec->flags & SEC_IN_MEMORY) != 0))
+      && sec->contents != NULL)
+    {
+      /* The section owns the contents, so hand them out without
+	 taking a reference.  */
+      w->data = sec->contents;
+      w->size = sz;
+      return TRUE;
+    }
+
+  if (sec->compress_status == COMPRESS_SECTION_NONE
+      && (sec->flags & (SEC_HAS_CONTENTS | SEC_IN_MEMORY
+			| SEC_CONSTRUCTOR)) == SEC_HAS_CONTENTS
+      && (abfd->xvec->_bfd_get_section_contents
+	  == _bfd_generic_get_section_contents))
+    {
+      ufile_ptr filesize = bfd_get_file_size (abfd);
+
+      /* Only map contents that lie wholly within the file (or archive
+	 member).  Anything else goes through the copy path, which
+	 reports the truncation or bad section size as it always has.  */
+      if (filesize != 0
+	  && sec->filepos >= 0
+	  && (ufile_ptr) sec->filepos <= filesize
+	  && sz <= filesize - sec->filepos
+	  && sz == (size_t) sz)
+	return bfd_get_file_window (abfd, sec->filepos, sz, w, FALSE);
+    }
+
+  /* Fall back to copying, and let the window own the buffer.  */
+  p = NULL;
+  if (!bfd_get_full_section_contents (abfd, sec, &p))
+    return FALSE;
+  w->i = (bfd_window_internal *) bfd_zmalloc (sizeof (bfd_window_internal));
+  if (w->i == NULL)
+    {
+      free (p);
+      return FALSE;
+    }
+  w->i->data = p;
+  w->i->size = sz;
+  w->i->mapped = 0;
+  w->i->refcount = 1;
+  w->data = p;
+  w->size = sz;
+  return TRUE;
+}
+
 /*
 FUNCTION
 	bfd_cache_section_contents
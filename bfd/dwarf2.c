@@ -89,6 +89,32 @@ struct dwarf2_debug
   /* Last comp unit in list above.  */
   struct comp_unit *last_comp_unit;
 
+  /* Number of comp units in the list above.  */
+  unsigned int num_comp_units;
+
+  /* The address ranges of the oldest UNIT_INDEX_UNITS comp units in
+     the list above, sorted by start address, so that the units which
+     may contain an address can be found without checking all of
+     them.  UNIT_INDEX_HEAD is the most recently read of those units,
+     or NULL if there is no index.  */
+  struct unit_arange *unit_index;
+  size_t unit_index_count;
+  unsigned int unit_index_units;
+  struct comp_unit *unit_index_head;
+
+  /* Units covered by the index whose address ranges aren't (or are no
+     longer) fully recorded in it, in reversed reading order.  These
+     are always checked.  UNIT_INDEX_DIRTY counts the ones added since
+     the index was built.  */
+  struct comp_unit **unit_index_extra;
+  size_t unit_index_extra_count;
+  unsigned int unit_index_dirty;
+
+  /* Scratch space for looking up an address in the index.  */
+  struct comp_unit **unit_index_matches;
+  struct comp_unit **unit_index_hits;
+  size_t unit_index_hits_size;
+
   /* Names of the debug sections.  */
   const struct dwarf_debug_section *debug_sections;
 
@@ -210,6 +236,17 @@ struct arange
   bfd_vma high;
 };
 
+/* An entry in the sorted address index of comp units.  */
+
+struct unit_arange
+{
+  bfd_vma low;
+  bfd_vma high;
+  /* The highest HIGH of this entry and all entries before it.  */
+  bfd_vma max_high;
+  struct comp_unit *unit;
+};
+
 /* A minimal decoding of DWARF2 compilation units.  We only decode
    what's needed to get to the line number information.  */
 
@@ -293,6 +330,10 @@ struct comp_unit
 
   /* TRUE if symbols are cached in hash table for faster lookup by name.  */
   bfd_boolean cached;
+
+  /* TRUE if all of this unit's address ranges are in the stash's unit
+     index.  */
+  bfd_boolean in_unit_index;
 };
 
 /* This data structure holds the information of an abbrev.  */
@@ -1684,6 +1725,54 @@ arange_add (const struct comp_unit *unit, struct arange *first_arange,
   return TRUE;
 }
 
+/* Note that the address ranges of UNIT have grown since the stash's
+   unit index was built, so that UNIT is always checked from now on.  */
+
+static void
+unit_index_mark_dirty (struct dwarf2_debug *stash, struct comp_unit *unit)
+{
+  size_t i;
+
+  /* UNIT_INDEX_EXTRA has room for every indexed unit.  Keep it in
+     reversed reading order.  */
+  i = stash->unit_index_extra_count;
+  while (i > 0
+	 && stash->unit_index_extra[i - 1]->info_ptr_unit < unit->info_ptr_unit)
+    {
+      stash->unit_index_extra[i] = stash->unit_index_extra[i - 1];
+      i--;
+    }
+  stash->unit_index_extra[i] = unit;
+  stash->unit_index_extra_count++;
+  stash->unit_index_dirty++;
+  unit->in_unit_index = FALSE;
+}
+
+/* Add the range LOW_PC..HIGH_PC of a line sequence to UNIT's address
+   ranges, unless one of them already covers it.  */
+
+static bfd_boolean
+comp_unit_add_line_arange (struct comp_unit *unit,
+			   bfd_vma low_pc, bfd_vma high_pc)
+{
+  struct arange *arange;
+
+  if (low_pc == high_pc)
+    return TRUE;
+
+  if (unit->arange.high != 0)
+    for (arange = &unit->arange; arange; arange = arange->next)
+      if (low_pc >= arange->low && high_pc <= arange->high)
+	return TRUE;
+
+  if (!arange_add (unit, &unit->arange, low_pc, high_pc))
+    return FALSE;
+
+  if (unit->in_unit_index)
+    unit_index_mark_dirty (unit->stash, unit);
+  return TRUE;
+}
+
 /* Compare function for line sequences.  */
 
 static int
@@ -2311,7 +2400,7 @@ decode_line_info (struct comp_unit *unit, struct dwarf2_debug *stash)
 		    low_pc = address;
 		  if (address > high_pc)
 		    high_pc = address;
-		  if (!arange_add (unit, &unit->arange, low_pc, high_pc))
+		  if (!comp_unit_add_line_arange (unit, low_pc, high_pc))
 		    goto line_fail;
 		  break;
 		case DW_LNE_set_address:
@@ -4237,6 +4326,216 @@ stash_maybe_enable_info_hash_tables (bfd *abfd, struct dwarf2_debug *stash)
   stash->info_hash_status = STASH_INFO_HASH_ON;
 }
 
+/* Compare function for the entries of the unit index.  */
+
+static int
+compare_unit_aranges (const void *a, const void *b)
+{
+  const struct unit_arange *arange1 = (const struct unit_arange *) a;
+  const struct unit_arange *arange2 = (const struct unit_arange *) b;
+
+  if (arange1->low < arange2->low)
+    return -1;
+  if (arange1->low > arange2->low)
+    return 1;
+  if (arange1->high < arange2->high)
+    return -1;
+  if (arange1->high > arange2->high)
+    return 1;
+  if (arange1->unit->info_ptr_unit < arange2->unit->info_ptr_unit)
+    return -1;
+  if (arange1->unit->info_ptr_unit > arange2->unit->info_ptr_unit)
+    return 1;
+  return 0;
+}
+
+/* Compare function putting comp units in reversed reading order.  */
+
+static int
+compare_units_reversed (const void *a, const void *b)
+{
+  const struct comp_unit *unit1 = *(const struct comp_unit * const *) a;
+  const struct comp_unit *unit2 = *(const struct comp_unit * const *) b;
+
+  if (unit1->info_ptr_unit > unit2->info_ptr_unit)
+    return -1;
+  if (unit1->info_ptr_unit < unit2->info_ptr_unit)
+    return 1;
+  return 0;
+}
+
+/* Rebuild the unit index of STASH if enough comp units have been read,
+   or have had their ranges grow, since it was last built that checking
+   them one by one is getting expensive.  Returns FALSE on memory
+   allocation failure.  */
+
+static bfd_boolean
+stash_maybe_update_unit_index (struct dwarf2_debug *stash)
+{
+  unsigned int pending;
+  struct unit_arange *index;
+  struct comp_unit **extra;
+  struct comp_unit **matches;
+  struct comp_unit *each;
+  struct arange *arange;
+  size_t count, extra_count, i;
+  bfd_vma max_high;
+
+  pending = (stash->num_comp_units - stash->unit_index_units
+	     + stash->unit_index_dirty);
+  if (pending <= 16 || pending * 16 < stash->unit_index_units)
+    return TRUE;
+
+  count = 0;
+  for (each = stash->all_comp_units; each; each = each->next_unit)
+    if (each->arange.high != 0)
+      for (arange = &each->arange; arange; arange = arange->next)
+	count++;
+
+  index = (struct unit_arange *) bfd_malloc (count * sizeof (*index) + 1);
+  extra = (struct comp_unit **) bfd_malloc (stash->num_comp_units
+					    * sizeof (*extra) + 1);
+  matches = (struct comp_unit **) bfd_malloc (count * sizeof (*matches) + 1);
+  if (index == NULL || extra == NULL || matches == NULL)
+    {
+      free (index);
+      free (extra);
+      free (matches);
+      return FALSE;
+    }
+
+  count = 0;
+  extra_count = 0;
+  for (each = stash->all_comp_units; each; each = each->next_unit)
+    {
+      each->in_unit_index = each->arange.high != 0;
+      if (!each->in_unit_index)
+	{
+	  extra[extra_count++] = each;
+	  continue;
+	}
+      for (arange = &each->arange; arange; arange = arange->next)
+	{
+	  index[count].low = arange->low;
+	  index[count].high = arange->high;
+	  index[count].unit = each;
+	  count++;
+	}
+    }
+
+  qsort (index, count, sizeof (*index), compare_unit_aranges);
+  max_high = 0;
+  for (i = 0; i < count; i++)
+    {
+      if (index[i].high > max_high)
+	max_high = index[i].high;
+      index[i].max_high = max_high;
+    }
+
+  free (stash->unit_index);
+  free (stash->unit_index_extra);
+  free (stash->unit_index_matches);
+  stash->unit_index = index;
+  stash->unit_index_count = count;
+  stash->unit_index_units = stash->num_comp_units;
+  stash->unit_index_head = stash->all_comp_units;
+  stash->unit_index_extra = extra;
+  stash->unit_index_extra_count = extra_count;
+  stash->unit_index_dirty = 0;
+  stash->unit_index_matches = matches;
+  return TRUE;
+}
+
+/* Return the comp units of STASH which may contain ADDR, in the order
+   they appear on the list of all comp units, and set *COUNT to their
+   number.  Units read after the unit index was built, and units whose
+   ranges aren't all in it, are always returned.  The array returned is
+   scratch space owned by STASH.  Returns NULL on memory allocation
+   failure.  */
+
+static struct comp_unit **
+stash_find_units_for_address (struct dwarf2_debug *stash, bfd_vma addr,
+			      size_t *count)
+{
+  struct comp_unit **hits;
+  struct comp_unit **matches;
+  struct comp_unit **extra;
+  struct comp_unit *each;
+  size_t needed, nhits, nmatches, i, j;
+  size_t lo, hi;
+
+  if (!stash_maybe_update_unit_index (stash))
+    return NULL;
+  matches = stash->unit_index_matches;
+  extra = stash->unit_index_extra;
+
+  needed = stash->unit_index_count + stash->num_comp_units + 1;
+  if (stash->unit_index_hits_size < needed)
+    {
+      hits = (struct comp_unit **) bfd_realloc (stash->unit_index_hits,
+						needed * sizeof (*hits));
+      if (hits == NULL)
+	return NULL;
+      stash->unit_index_hits = hits;
+      stash->unit_index_hits_size = needed;
+    }
+  hits = stash->unit_index_hits;
+
+  /* First the units read since the index was built.  */
+  nhits = 0;
+  for (each = stash->all_comp_units;
+       each != stash->unit_index_head;
+       each = each->next_unit)
+    hits[nhits++] = each;
+
+  /* Then the indexed units with a range containing ADDR.  Find the
+     entries starting at or below ADDR, and walk back from the last of
+     them for as long as an earlier entry could still reach ADDR.  */
+  lo = 0;
+  hi = stash->unit_index_count;
+  while (lo < hi)
+    {
+      size_t mid = (lo + hi) / 2;
+
+      if (stash->unit_index[mid].low <= addr)
+	lo = mid + 1;
+      else
+	hi = mid;
+    }
+  nmatches = 0;
+  while (lo > 0 && stash->unit_index[lo - 1].max_high > addr)
+    {
+      lo--;
+      if (stash->unit_index[lo].high > addr)
+	matches[nmatches++] = stash->unit_index[lo].unit;
+    }
+  if (nmatches > 1)
+    qsort (matches, nmatches, sizeof (*matches), compare_units_reversed);
+
+  /* Merge those with the units that are always checked, dropping
+     duplicates.  */
+  i = 0;
+  j = 0;
+  while (i < nmatches || j < stash->unit_index_extra_count)
+    {
+      if (j >= stash->unit_index_extra_count
+	  || (i < nmatches
+	      && matches[i]->info_ptr_unit >= extra[j]->info_ptr_unit))
+	{
+	  if (j < stash->unit_index_extra_count && matches[i] == extra[j])
+	    j++;
+	  each = matches[i++];
+	}
+      else
+	each = extra[j++];
+      if (nhits == 0 || hits[nhits - 1] != each)
+	hits[nhits++] = each;
+    }
+
+  *count = nhits;
+  return hits;
+}
+
 /* Find the file and line associated with a symbol and address using the
    info hash tables of a stash. If there is a match, the function returns
    TRUE and update the locations pointed to by filename_ptr and linenumber_ptr;
@@ -4675,11 +4974,22 @@ _bfd_dwarf2_find_nearest_line (bfd *abfd,
       struct funcinfo *local_function = NULL;
       unsigned int local_linenumber = 0;
       unsigned int local_discriminator = 0;
+      struct comp_unit **units;
+      size_t num_units, u;
+
+      /* Only look at the units which may contain ADDR, but in the
+	 same order as the list of all units so that the result is
+	 the same.  */
+      units = stash_find_units_for_address (stash, addr, &num_units);
+      if (units == NULL)
+	goto done;
 
-      for (each = stash->all_comp_units; each; each = each->next_unit)
+      for (u = 0; u < num_units; u++)
 	{
 	  bfd_vma range = (bfd_vma) -1;
 
+	  each = units[u];
+
 	  found = ((each->arange.high == 0
 		    || comp_unit_contains_address (each, addr))
 		   && (range = comp_unit_find_nearest_line (each, addr,
@@ -4805,6 +5115,7 @@ _bfd_dwarf2_find_nearest_line (bfd *abfd,
 
 	  each->next_unit = stash->all_comp_units;
 	  stash->all_comp_units = each;
+	  stash->num_comp_units++;
 
 	  /* DW_AT_low_pc and DW_AT_high_pc are optional for
 	     compilation units.  If we don't have them (i.e.,
@@ -4965,6 +5276,10 @@ _bfd_dwarf2_cleanup_debug_info (bfd *abfd, void **pinfo)
 	}
     }
 
+  free (stash->unit_index);
+  free (stash->unit_index_extra);
+  free (stash->unit_index_matches);
+  free (stash->unit_index_hits);
   if (stash->funcinfo_hash_table)
     bfd_hash_table_free (&stash->funcinfo_hash_table->base);
   if (stash->varinfo_hash_table)
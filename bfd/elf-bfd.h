@@ -648,6 +648,11 @@ struct elf_link_hash_table
   asection *irelplt;
   asection *irelifunc;
   asection *dynsym;
+
+  /* The .relr.dyn section holding packed relative relocations, and
+     whether its size may still shrink during layout.  */
+  asection *srelrdyn;
+  bfd_boolean srelrdyn_sized;
 };
 
 /* Look up an entry in an ELF linker hash table.  */
@@ -1076,6 +1081,14 @@ struct elf_backend_data
   bfd_boolean (*elf_backend_size_dynamic_sections)
     (bfd *output_bfd, struct bfd_link_info *info);
 
+  /* The RELATIVE_RELOCS function, if defined, is called by the ELF
+     backend linker after section addresses have been assigned.  It
+     returns in *ADDRS a malloc'd array of the addresses of the
+     relative relocations which the backend has moved to .relr.dyn,
+     and their number in *COUNT.  The addresses need not be sorted.  */
+  bfd_boolean (*elf_backend_relative_relocs)
+    (struct bfd_link_info *info, bfd_vma **addrs, bfd_size_type *count);
+
   /* Set TEXT_INDEX_SECTION and DATA_INDEX_SECTION, the output sections
      we keep to use as a base for relocs and symbols.  */
   void (*elf_backend_init_index_section)
@@ -2242,6 +2255,8 @@ extern bfd_boolean _bfd_elf_strtab_emit
   (bfd *, struct elf_strtab_hash *);
 extern void _bfd_elf_strtab_finalize
   (struct elf_strtab_hash *);
+extern bfd_size_type _bfd_elf_strtab_saved_size
+  (struct elf_strtab_hash *);
 
 extern bfd_boolean bfd_elf_parse_eh_frame_entries
   (bfd *, struct bfd_link_info *);
@@ -53,6 +53,8 @@ struct elf_strtab_hash
   size_t alloced;
   /* Final strtab size.  */
   bfd_size_type sec_size;
+  /* Bytes saved by suffix merging.  */
+  bfd_size_type saved_size;
   /* Array of pointers to strtab entries.  */
   struct elf_strtab_hash_entry **array;
 };
@@ -109,6 +111,7 @@ _bfd_elf_strtab_init (void)
     }
 
   table->sec_size = 0;
+  table->saved_size = 0;
   table->size = 1;
   table->alloced = 64;
   amt = sizeof (struct elf_strtab_hasn_entry *);
@@ -352,6 +355,130 @@ is_suffix (const struct elf_strtab_hash_entry *A,
 		 B->root.string, B->len - 1) == 0;
 }
 
+/* Return the character DEPTH places from the end of the string for
+   entry E, or zero if the string is shorter than that.  E->len must
+   not include the zero terminator.  */
+
+static inline int
+strrevchar (const struct elf_strtab_hash_entry *e, unsigned int depth)
+{
+  if (depth >= (unsigned int) e->len)
+    return 0;
+  return ((const unsigned char *) e->root.string)[e->len - 1 - depth];
+}
+
+static inline void
+strtab_swap (struct elf_strtab_hash_entry **a, size_t i, size_t j)
+{
+  struct elf_strtab_hash_entry *t = a[i];
+  a[i] = a[j];
+  a[j] = t;
+}
+
+static inline void
+strtab_vecswap (struct elf_strtab_hash_entry **a, size_t i, size_t j,
+		size_t n)
+{
+  while (n-- > 0)
+    strtab_swap (a, i++, j++);
+}
+
+/* Sort the N entries at A into the order given by strrevcmp, given
+   that they all have the same last DEPTH characters.  This is a
+   multikey quicksort: each partitioning step looks at one character,
+   so unlike qsort with strrevcmp the common suffixes of the strings
+   are not compared over and over again.  */
+
+static void
+strrevsort (struct elf_strtab_hash_entry **a, size_t n, unsigned int depth)
+{
+  while (n > 1)
+    {
+      size_t lt, b, c, gt, r, nlt, neq, ngt;
+      int v, ch;
+
+      if (n < 16)
+	{
+	  size_t i, j;
+
+	  for (i = 1; i < n; i++)
+	    for (j = i; j > 0 && strrevcmp (&a[j - 1], &a[j]) > 0; j--)
+	      strtab_swap (a, j - 1, j);
+	  return;
+	}
+
+      /* Median of three pivot, moved to the front.  */
+      {
+	int x = strrevchar (a[0], depth);
+	int y = strrevchar (a[n / 2], depth);
+	int z = strrevchar (a[n - 1], depth);
+
+	if ((x < y) == (y < z))
+	  strtab_swap (a, 0, n / 2);
+	else if ((y < z) == (z < x))
+	  strtab_swap (a, 0, n - 1);
+      }
+      v = strrevchar (a[0], depth);
+
+      /* Split into [0,lt) equal, [lt,b) less, (c,gt] greater and
+	 (gt,n) equal, then move the equal runs to the middle.  */
+      lt = b = 1;
+      c = gt = n - 1;
+      for (;;)
+	{
+	  while (b <= c && (ch = strrevchar (a[b], depth)) <= v)
+	    {
+	      if (ch == v)
+		strtab_swap (a, lt++, b);
+	      b++;
+	    }
+	  while (b <= c && (ch = strrevchar (a[c], depth)) >= v)
+	    {
+	      if (ch == v)
+		strtab_swap (a, c, gt--);
+	      c--;
+	    }
+	  if (b > c)
+	    break;
+	  strtab_swap (a, b++, c--);
+	}
+      nlt = b - lt;
+      ngt = gt - c;
+      neq = n - nlt - ngt;
+      r = lt < nlt ? lt : nlt;
+      strtab_vecswap (a, 0, b - r, r);
+      r = n - 1 - gt < ngt ? n - 1 - gt : ngt;
+      strtab_vecswap (a, b, n - r, r);
+
+      /* Recurse on the two smaller parts and loop on the largest, so
+	 that the recursion depth stays logarithmic.  Strings in the
+	 equal part have all ended if V is zero, and then are sorted.  */
+      if (v == 0)
+	neq = 0;
+      if (nlt >= neq && nlt >= ngt)
+	{
+	  strrevsort (a + nlt, neq, depth + 1);
+	  strrevsort (a + n - ngt, ngt, depth);
+	  n = nlt;
+	}
+      else if (ngt >= neq)
+	{
+	  strrevsort (a, nlt, depth);
+	  strrevsort (a + nlt, neq, depth + 1);
+	  a += n - ngt;
+	  n = ngt;
+	}
+      else
+	{
+	  strrevsort (a, nlt, depth);
+	  strrevsort (a + n - ngt, ngt, depth);
+	  a += nlt;
+	  n = neq;
+	  depth++;
+	}
+    }
+}
+
 /* This function assigns final string table offsets for used strings,
    merging strings matching suffixes of longer strings if possible.  */
 
@@ -385,7 +512,7 @@ _bfd_elf_strtab_finalize (struct elf_strtab_hash *tab)
   size = a - array;
   if (size != 0)
     {
-      qsort (array, size, sizeof (struct elf_strtab_hash_entry *), strrevcmp);
+      strrevsort (array, size, 0);
 
       /* Loop over the sorted array and merge suffixes.  Start from the
 	 end because we want eg.
@@ -437,10 +564,23 @@ alloc_failure:
   tab->sec_size = sec_size;
 
   /* Adjust the rest.  */
+  tab->saved_size = 0;
   for (i = 1; i < tab->size; ++i)
     {
       e = tab->array[i];
       if (e->refcount && e->len < 0)
-	e->u.index = e->u.suffix->u.index + (e->u.suffix->len + e->len);
+	{
+	  e->u.index = e->u.suffix->u.index + (e->u.suffix->len + e->len);
+	  tab->saved_size -= e->len;
+	}
     }
 }
+
+/* Return the number of bytes saved by suffix merging when TAB was
+   last finalized.  */
+
+bfd_size_type
+_bfd_elf_strtab_saved_size (struct elf_strtab_hash *tab)
+{
+  return tab->saved_size;
+}
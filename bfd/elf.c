@@ -1751,6 +1751,9 @@ _bfd_elf_print_private_bfd_data (bfd *abfd, void *farg)
 	    case DT_FLAGS: name = "FLAGS"; break;
 	    case DT_PREINIT_ARRAY: name = "PREINIT_ARRAY"; break;
 	    case DT_PREINIT_ARRAYSZ: name = "PREINIT_ARRAYSZ"; break;
+	    case DT_RELRSZ: name = "RELRSZ"; break;
+	    case DT_RELR: name = "RELR"; break;
+	    case DT_RELRENT: name = "RELRENT"; break;
 	    case DT_CHECKSUM: name = "CHECKSUM"; break;
 	    case DT_PLTPADSZ: name = "PLTPADSZ"; break;
 	    case DT_MOVEENT: name = "MOVEENT"; break;
@@ -2070,6 +2073,7 @@ bfd_section_from_shdr (bfd *abfd, unsigned int shindex)
     case SHT_INIT_ARRAY:	/* .init_array section.  */
     case SHT_FINI_ARRAY:	/* .fini_array section.  */
     case SHT_PREINIT_ARRAY:	/* .preinit_array section.  */
+    case SHT_RELR:		/* .relr.dyn section.  */
     case SHT_GNU_LIBLIST:	/* .gnu.liblist section.  */
     case SHT_GNU_HASH:		/* .gnu.hash section.  */
       ret = _bfd_elf_make_section_from_shdr (abfd, hdr, name, shindex);
@@ -2699,6 +2703,7 @@ static const struct bfd_elf_special_section special_sections_r[] =
 {
   { STRING_COMMA_LEN (".rodata"), -2, SHT_PROGBITS, SHF_ALLOC },
   { STRING_COMMA_LEN (".rodata1"), 0, SHT_PROGBITS, SHF_ALLOC },
+  { STRING_COMMA_LEN (".relr.dyn"), 0, SHT_RELR,   SHF_ALLOC },
   { STRING_COMMA_LEN (".rela"),	  -1, SHT_RELA,	    0 },
   { STRING_COMMA_LEN (".rel"),	  -1, SHT_REL,	    0 },
   { NULL,		    0,	   0, 0,	    0 }
@@ -3302,6 +3307,7 @@ elf_fake_sections (bfd *abfd, asection *asect, void *fsarg)
     case SHT_INIT_ARRAY:
     case SHT_FINI_ARRAY:
     case SHT_PREINIT_ARRAY:
+    case SHT_RELR:
       this_hdr->sh_entsize = bed->s->arch_size / 8;
       break;
 
@@ -3284,15 +3284,33 @@ direct:
 		    }
 		}
 
-	      sreloc = elf_section_data (input_section)->sreloc;
-
-	      if (sreloc == NULL || sreloc->contents == NULL)
+	      /* Relative relocations chosen for DT_RELR by
+		 elf_x86_size_relative_relocs have no space in SRELOC;
+		 the unrelocated contents hold their addends.  */
+	      if (!skip
+		  && _bfd_x86_elf_packed_relative_reloc_p (htab,
+							   input_section,
+							   rel->r_offset))
 		{
-		  r = bfd_reloc_notsupported;
-		  goto check_relocation_error;
+		  if (!relocate
+		      || ELF64_R_TYPE (outrel.r_info) != R_X86_64_RELATIVE)
+		    {
+		      r = bfd_reloc_notsupported;
+		      goto check_relocation_error;
+		    }
 		}
+	      else
+		{
+		  sreloc = elf_section_data (input_section)->sreloc;
 
-	      elf_append_rela (output_bfd, sreloc, &outrel);
+		  if (sreloc == NULL || sreloc->contents == NULL)
+		    {
+		      r = bfd_reloc_notsupported;
+		      goto check_relocation_error;
+		    }
+
+		  elf_append_rela (output_bfd, sreloc, &outrel);
+		}
 
 	      /* If this reloc is against an external symbol, we do
 		 not want to fiddle with the addend.  Otherwise, we
@@ -4538,6 +4556,20 @@ elf_x86_64_finish_dynamic_sections (bfd *output_bfd,
   if (htab == NULL)
     return FALSE;
 
+  /* Each relocation moved to .relr.dyn must have been resolved as a
+     relative relocation by elf_x86_64_relocate_section.  */
+  if (htab->relative_reloc_done != htab->relative_reloc_count)
+    {
+      _bfd_error_handler
+	/* xgettext:c-format */
+	(_("%pB: only %" PRIu64 " of %" PRIu64 " packed relative"
+	   " relocations were applied"),
+	 output_bfd, (uint64_t) htab->relative_reloc_done,
+	 (uint64_t) htab->relative_reloc_count);
+      bfd_set_error (bfd_error_bad_value);
+      return FALSE;
+    }
+
   if (! htab->elf.dynamic_sections_created)
     return TRUE;
 
@@ -5152,6 +5184,7 @@ elf_x86_64_special_sections[]=
 #define elf_backend_relocs_compatible	    elf_x86_64_relocs_compatible
 #define elf_backend_check_relocs	    elf_x86_64_check_relocs
 #define elf_backend_create_dynamic_sections _bfd_elf_create_dynamic_sections
+#define elf_backend_relative_relocs	    _bfd_x86_elf_relative_relocs
 #define elf_backend_finish_dynamic_sections elf_x86_64_finish_dynamic_sections
 #define elf_backend_finish_dynamic_symbol   elf_x86_64_finish_dynamic_symbol
 #define elf_backend_output_arch_local_syms  elf_x86_64_output_arch_local_syms
@@ -5485,6 +5518,8 @@ elf32_x86_64_nacl_elf_object_p (bfd *abfd)
 #define elf_backend_size_info \
   _bfd_elf32_size_info
 
+#undef elf_backend_relative_relocs
+
 #undef	elf32_bed
 #define	elf32_bed			elf32_x86_64_bed
 
@@ -5493,6 +5528,8 @@ elf32_x86_64_nacl_elf_object_p (bfd *abfd)
 /* Restore defaults.  */
 #undef	elf_backend_object_p
 #define elf_backend_object_p		    elf64_x86_64_elf_object_p
+#undef	elf_backend_relative_relocs
+#define elf_backend_relative_relocs	    _bfd_x86_elf_relative_relocs
 #undef	elf_backend_bfd_from_remote_memory
 #undef	elf_backend_size_info
 #undef	elf_backend_modify_segment_map
@@ -5638,4 +5675,6 @@ elf64_k1om_elf_object_p (bfd *abfd)
 #define elf_backend_size_info \
   _bfd_elf32_size_info
 
+#undef elf_backend_relative_relocs
+
 #include "elf32-target.h"
@@ -419,6 +419,21 @@ _bfd_elf_create_dynamic_sections (bfd *abfd, struct bfd_link_info *info)
     return FALSE;
   htab->srelplt = s;
 
+  if (info->enable_dt_relr
+      && bfd_link_pic (info)
+      && bed->elf_backend_relative_relocs != NULL)
+    {
+      /* The .relr.dyn section holds the relative relocations which
+	 the backend packs into DT_RELR format.  Its size is set by
+	 bfd_elf_size_relative_relocs once addresses are known.  */
+      s = bfd_make_section_anyway_with_flags (abfd, ".relr.dyn",
+					      flags | SEC_READONLY);
+      if (s == NULL
+	  || ! bfd_set_section_alignment (abfd, s, bed->s->log_file_align))
+	return FALSE;
+      htab->srelrdyn = s;
+    }
+
   if (! _bfd_elf_create_got_section (abfd, info))
     return FALSE;
 
@@ -2231,6 +2246,165 @@ _bfd_elf_link_find_version_dependencies (struct elf_link_hash_entry *h,
   return TRUE;
 }
 
+/* glibc refuses to load an object using DT_RELR unless it depends on
+   the GLIBC_ABI_DT_RELR version of libc.  Add that dependency if the
+   output already needs a GLIBC_2.* version from libc.  */
+
+static bfd_boolean
+elf_link_add_dt_relr_version (struct bfd_link_info *info)
+{
+  static const char relr_version[] = "GLIBC_ABI_DT_RELR";
+  bfd *output_bfd = info->output_bfd;
+  Elf_Internal_Verneed *t, *libc;
+  Elf_Internal_Vernaux *a;
+  unsigned int vers;
+  bfd_boolean glibc;
+
+  /* Find libc, and the last version index used, as
+     _bfd_elf_link_find_version_dependencies numbers the references
+     after the version definitions.  */
+  libc = NULL;
+  vers = elf_tdata (output_bfd)->cverdefs;
+  if (vers == 0)
+    vers = 1;
+  for (t = elf_tdata (output_bfd)->verref; t != NULL; t = t->vn_nextref)
+    {
+      const char *soname = elf_dt_name (t->vn_bfd);
+
+      if (soname != NULL && CONST_STRNEQ (soname, "libc.so."))
+	libc = t;
+      for (a = t->vn_auxptr; a != NULL; a = a->vna_nextptr)
+	if (a->vna_other > vers)
+	  vers = a->vna_other;
+    }
+  t = libc;
+  if (t == NULL)
+    return TRUE;
+
+  glibc = FALSE;
+  for (a = t->vn_auxptr; a != NULL; a = a->vna_nextptr)
+    {
+      if (strcmp (a->vna_nodename, relr_version) == 0)
+	return TRUE;
+      if (CONST_STRNEQ (a->vna_nodename, "GLIBC_2."))
+	glibc = TRUE;
+    }
+  if (!glibc)
+    return TRUE;
+
+  a = (Elf_Internal_Vernaux *) bfd_zalloc (output_bfd, sizeof *a);
+  if (a == NULL)
+    return FALSE;
+
+  a->vna_nodename = relr_version;
+  a->vna_flags = 0;
+  a->vna_nextptr = t->vn_auxptr;
+  a->vna_other = vers + 1;
+  t->vn_auxptr = a;
+
+  return TRUE;
+}
+
+/* Build the version dependency section, .gnu.version_r, from the
+   version references of OUTPUT_BFD.  */
+
+static bfd_boolean
+elf_link_size_verneed_section (bfd *output_bfd, struct bfd_link_info *info)
+{
+  asection *s;
+
+  s = bfd_get_linker_section (elf_hash_table (info)->dynobj,
+			      ".gnu.version_r");
+  BFD_ASSERT (s != NULL);
+
+  if (elf_tdata (output_bfd)->verref == NULL)
+    s->flags |= SEC_EXCLUDE;
+  else
+    {
+      Elf_Internal_Verneed *vn;
+      unsigned int size;
+      unsigned int crefs;
+      bfd_byte *p;
+
+      /* Build the version dependency section.  */
+      size = 0;
+      crefs = 0;
+      for (vn = elf_tdata (output_bfd)->verref;
+	   vn != NULL;
+	   vn = vn->vn_nextref)
+	{
+	  Elf_Internal_Vernaux *a;
+
+	  size += sizeof (Elf_External_Verneed);
+	  ++crefs;
+	  for (a = vn->vn_auxptr; a != NULL; a = a->vna_nextptr)
+	    size += sizeof (Elf_External_Vernaux);
+	}
+
+      s->size = size;
+      s->contents = (unsigned char *) bfd_alloc (output_bfd, s->size);
+      if (s->contents == NULL)
+	return FALSE;
+
+      p = s->contents;
+      for (vn = elf_tdata (output_bfd)->verref;
+	   vn != NULL;
+	   vn = vn->vn_nextref)
+	{
+	  unsigned int caux;
+	  Elf_Internal_Vernaux *a;
+	  size_t indx;
+
+	  caux = 0;
+	  for (a = vn->vn_auxptr; a != NULL; a = a->vna_nextptr)
+	    ++caux;
+
+	  vn->vn_version = VER_NEED_CURRENT;
+	  vn->vn_cnt = caux;
+	  indx = _bfd_elf_strtab_add (elf_hash_table (info)->dynstr,
+				      elf_dt_name (vn->vn_bfd) != NULL
+				      ? elf_dt_name (vn->vn_bfd)
+				      : lbasename (vn->vn_bfd->filename),
+				      FALSE);
+	  if (indx == (size_t) -1)
+	    return FALSE;
+	  vn->vn_file = indx;
+	  vn->vn_aux = sizeof (Elf_External_Verneed);
+	  if (vn->vn_nextref == NULL)
+	    vn->vn_next = 0;
+	  else
+	    vn->vn_next = (sizeof (Elf_External_Verneed)
+			   + caux * sizeof (Elf_External_Vernaux));
+
+	  _bfd_elf_swap_verneed_out (output_bfd, vn,
+				     (Elf_External_Verneed *) p);
+	  p += sizeof (Elf_External_Verneed);
+
+	  for (a = vn->vn_auxptr; a != NULL; a = a->vna_nextptr)
+	    {
+	      a->vna_hash = bfd_elf_hash (a->vna_nodename);
+	      indx = _bfd_elf_strtab_add (elf_hash_table (info)->dynstr,
+					  a->vna_nodename, FALSE);
+	      if (indx == (size_t) -1)
+		return FALSE;
+	      a->vna_name = indx;
+	      if (a->vna_nextptr == NULL)
+		a->vna_next = 0;
+	      else
+		a->vna_next = sizeof (Elf_External_Vernaux);
+
+	      _bfd_elf_swap_vernaux_out (output_bfd, a,
+					 (Elf_External_Vernaux *) p);
+	      p += sizeof (Elf_External_Vernaux);
+	    }
+	}
+
+      elf_tdata (output_bfd)->cverrefs = crefs;
+    }
+
+  return TRUE;
+}
+
 /* Return TRUE and set *HIDE to TRUE if the versioned symbol is
    hidden.  Set *T_P to NULL if there is no match.  */
 
@@ -3623,6 +3797,25 @@ elf_adjust_dynstr_offsets (struct elf_link_hash_entry *h, void *data)
   return TRUE;
 }
 
+/* Finalize string table TAB, adding the time taken and the space
+   saved to the link statistics if they are wanted.  */
+
+static void
+elf_link_strtab_finalize (struct bfd_link_info *info,
+			  struct elf_strtab_hash *tab)
+{
+  long start = 0;
+
+  if (info->stats != NULL)
+    start = get_run_time ();
+  _bfd_elf_strtab_finalize (tab);
+  if (info->stats != NULL)
+    {
+      info->stats->strtab_time += get_run_time () - start;
+      info->stats->strtab_saved += _bfd_elf_strtab_saved_size (tab);
+    }
+}
+
 /* Assign string offsets in .dynstr, update all structures referencing
    them.  */
 
@@ -3638,7 +3831,7 @@ elf_finalize_dynstr (bfd *output_bfd, struct bfd_link_info *info)
   const struct elf_backend_data *bed;
   bfd_byte *extdyn;
 
-  _bfd_elf_strtab_finalize (dynstr);
+  elf_link_strtab_finalize (info, dynstr);
   size = _bfd_elf_strtab_size (dynstr);
 
   bed = get_elf_backend_data (dynobj);
@@ -5614,6 +5807,8 @@ elf_link_add_archive_symbols (bfd *abfd, struct bfd_link_info *info)
 {
   symindex c;
   unsigned char *included = NULL;
+  unsigned char *member_included;
+  unsigned int *symdef_member;
   carsym *symdefs;
   bfd_boolean loop;
   bfd_size_type amt;
@@ -5636,11 +5831,15 @@ elf_link_add_archive_symbols (bfd *abfd, struct bfd_link_info *info)
   c = bfd_ardata (abfd)->symdef_count;
   if (c == 0)
     return TRUE;
+  if (!_bfd_archive_index_symdefs (abfd))
+    return FALSE;
+  symdef_member = bfd_ardata (abfd)->symdef_member;
   amt = c;
-  amt *= sizeof (*included);
+  amt += bfd_ardata (abfd)->member_count;
   included = (unsigned char *) bfd_zmalloc (amt);
   if (included == NULL)
     return FALSE;
+  member_included = included + c;
 
   symdefs = bfd_ardata (abfd)->symdefs;
   bed = get_elf_backend_data (abfd);
@@ -5648,13 +5847,11 @@ elf_link_add_archive_symbols (bfd *abfd, struct bfd_link_info *info)
 
   do
     {
-      file_ptr last;
       symindex i;
       carsym *symdef;
       carsym *symdefend;
 
       loop = FALSE;
-      last = -1;
 
       symdef = symdefs;
       symdefend = symdef + c;
@@ -5663,15 +5860,9 @@ elf_link_add_archive_symbols (bfd *abfd, struct bfd_link_info *info)
 	  struct elf_link_hash_entry *h;
 	  bfd *element;
 	  struct bfd_link_hash_entry *undefs_tail;
-	  symindex mark;
 
-	  if (included[i])
+	  if (included[i] || member_included[symdef_member[i]])
 	    continue;
-	  if (symdef->file_offset == last)
-	    {
-	      included[i] = TRUE;
-	      continue;
-	    }
 
 	  h = archive_symbol_lookup (abfd, info, symdef->name);
 	  if (h == (struct elf_link_hash_entry *) -1)
@@ -5731,21 +5922,8 @@ elf_link_add_archive_symbols (bfd *abfd, struct bfd_link_info *info)
 	  if (undefs_tail != info->hash->undefs_tail)
 	    loop = TRUE;
 
-	  /* Look backward to mark all symbols from this object file
-	     which we have already seen in this pass.  */
-	  mark = i;
-	  do
-	    {
-	      included[mark] = TRUE;
-	      if (mark == 0)
-		break;
-	      --mark;
-	    }
-	  while (symdefs[mark].file_offset == symdef->file_offset);
-
-	  /* We mark subsequent symbols from this object file as we go
-	     on through the loop.  */
-	  last = symdef->file_offset;
+	  /* Don't look at any symbol from this object file again.  */
+	  member_included[symdef_member[i]] = TRUE;
 	}
     }
   while (loop);
@@ -6625,14 +6803,10 @@ bfd_elf_size_dynamic_sections (bfd *output_bfd,
 
   if (dynobj != NULL && elf_hash_table (info)->dynamic_sections_created)
     {
-      asection *s;
       struct elf_find_verdep_info sinfo;
 
       /* Work out the size of the version reference section.  */
 
-      s = bfd_get_linker_section (dynobj, ".gnu.version_r");
-      BFD_ASSERT (s != NULL);
-
       sinfo.info = info;
       sinfo.vers = elf_tdata (output_bfd)->cverdefs;
       if (sinfo.vers == 0)
@@ -6645,90 +6819,11 @@ bfd_elf_size_dynamic_sections (bfd *output_bfd,
       if (sinfo.failed)
 	return FALSE;
 
-      if (elf_tdata (output_bfd)->verref == NULL)
-	s->flags |= SEC_EXCLUDE;
-      else
-	{
-	  Elf_Internal_Verneed *vn;
-	  unsigned int size;
-	  unsigned int crefs;
-	  bfd_byte *p;
-
-	  /* Build the version dependency section.  */
-	  size = 0;
-	  crefs = 0;
-	  for (vn = elf_tdata (output_bfd)->verref;
-	       vn != NULL;
-	       vn = vn->vn_nextref)
-	    {
-	      Elf_Internal_Vernaux *a;
-
-	      size += sizeof (Elf_External_Verneed);
-	      ++crefs;
-	      for (a = vn->vn_auxptr; a != NULL; a = a->vna_nextptr)
-		size += sizeof (Elf_External_Vernaux);
-	    }
-
-	  s->size = size;
-	  s->contents = (unsigned char *) bfd_alloc (output_bfd, s->size);
-	  if (s->contents == NULL)
-	    return FALSE;
-
-	  p = s->contents;
-	  for (vn = elf_tdata (output_bfd)->verref;
-	       vn != NULL;
-	       vn = vn->vn_nextref)
-	    {
-	      unsigned int caux;
-	      Elf_Internal_Vernaux *a;
-	      size_t indx;
-
-	      caux = 0;
-	      for (a = vn->vn_auxptr; a != NULL; a = a->vna_nextptr)
-		++caux;
-
-	      vn->vn_version = VER_NEED_CURRENT;
-	      vn->vn_cnt = caux;
-	      indx = _bfd_elf_strtab_add (elf_hash_table (info)->dynstr,
-					  elf_dt_name (vn->vn_bfd) != NULL
-					  ? elf_dt_name (vn->vn_bfd)
-					  : lbasename (vn->vn_bfd->filename),
-					  FALSE);
-	      if (indx == (size_t) -1)
-		return FALSE;
-	      vn->vn_file = indx;
-	      vn->vn_aux = sizeof (Elf_External_Verneed);
-	      if (vn->vn_nextref == NULL)
-		vn->vn_next = 0;
-	      else
-		vn->vn_next = (sizeof (Elf_External_Verneed)
-			       + caux * sizeof (Elf_External_Vernaux));
-
-	      _bfd_elf_swap_verneed_out (output_bfd, vn,
-					 (Elf_External_Verneed *) p);
-	      p += sizeof (Elf_External_Verneed);
-
-	      for (a = vn->vn_auxptr; a != NULL; a = a->vna_nextptr)
-		{
-		  a->vna_hash = bfd_elf_hash (a->vna_nodename);
-		  indx = _bfd_elf_strtab_add (elf_hash_table (info)->dynstr,
-					      a->vna_nodename, FALSE);
-		  if (indx == (size_t) -1)
-		    return FALSE;
-		  a->vna_name = indx;
-		  if (a->vna_nextptr == NULL)
-		    a->vna_next = 0;
-		  else
-		    a->vna_next = sizeof (Elf_External_Vernaux);
-
-		  _bfd_elf_swap_vernaux_out (output_bfd, a,
-					     (Elf_External_Vernaux *) p);
-		  p += sizeof (Elf_External_Vernaux);
-		}
-	    }
-
-	  elf_tdata (output_bfd)->cverrefs = crefs;
-	}
+      /* With .relr.dyn, wait until the backend has sized it to know
+	 whether GLIBC_ABI_DT_RELR is needed.  */
+      if (elf_hash_table (info)->srelrdyn == NULL
+	  && !elf_link_size_verneed_section (output_bfd, info))
+	return FALSE;
     }
 
   /* Any syms created from now on start with -1 in
@@ -6994,6 +7089,25 @@ bfd_elf_size_dynamic_sections (bfd *output_bfd,
 
   if (dynobj != NULL && elf_hash_table (info)->dynamic_sections_created)
     {
+      asection *srelrdyn = elf_hash_table (info)->srelrdyn;
+
+      /* The backend has set an upper bound on the size of .relr.dyn;
+	 bfd_elf_size_relative_relocs refines it during layout.  */
+      if (srelrdyn != NULL)
+	{
+	  if (srelrdyn->size == 0)
+	    srelrdyn->flags |= SEC_EXCLUDE;
+	  else if (!_bfd_elf_add_dynamic_entry (info, DT_RELR, 0)
+		   || !_bfd_elf_add_dynamic_entry (info, DT_RELRSZ, 0)
+		   || !_bfd_elf_add_dynamic_entry (info, DT_RELRENT,
+						   bed->s->arch_size / 8)
+		   || !elf_link_add_dt_relr_version (info))
+	    return FALSE;
+
+	  if (!elf_link_size_verneed_section (output_bfd, info))
+	    return FALSE;
+	}
+
       if (elf_tdata (output_bfd)->cverdefs)
 	{
 	  unsigned int crefs = elf_tdata (output_bfd)->cverdefs;
@@ -11694,6 +11808,204 @@ elf_final_link_free (bfd *obfd, struct elf_final_link_info *flinfo)
     }
 }
 
+/* Compare two addresses for qsort.  */
+
+static int
+elf_link_relr_cmp (const void *a, const void *b)
+{
+  bfd_vma va = *(const bfd_vma *) a;
+  bfd_vma vb = *(const bfd_vma *) b;
+
+  return va < vb ? -1 : va > vb ? 1 : 0;
+}
+
+/* Fetch from the backend the addresses of the relative relocations
+   packed into .relr.dyn, sorted in increasing order.  */
+
+static bfd_boolean
+elf_link_relr_addrs (struct bfd_link_info *info, bfd_vma **paddrs,
+		     bfd_size_type *pcount)
+{
+  const struct elf_backend_data *bed;
+  unsigned int wordsize;
+  bfd_size_type i;
+  bfd_vma *addrs;
+
+  bed = get_elf_backend_data (info->output_bfd);
+  if (!bed->elf_backend_relative_relocs (info, paddrs, pcount))
+    return FALSE;
+
+  addrs = *paddrs;
+  qsort (addrs, *pcount, sizeof (*addrs), elf_link_relr_cmp);
+
+  /* An entry in .relr.dyn can only describe a unique, word aligned
+     address.  */
+  wordsize = bed->s->arch_size / 8;
+  for (i = 0; i < *pcount; i++)
+    if (addrs[i] % wordsize != 0
+	|| (i != 0 && addrs[i] == addrs[i - 1]))
+      {
+	_bfd_error_handler
+	  /* xgettext:c-format */
+	  (_("%pB: invalid packed relative relocation at %#" PRIx64),
+	   info->output_bfd, (uint64_t) addrs[i]);
+	free (addrs);
+	bfd_set_error (bfd_error_bad_value);
+	return FALSE;
+      }
+
+  return TRUE;
+}
+
+/* Encode the COUNT sorted addresses in ADDRS in DT_RELR format and
+   return the number of bytes needed.  The encoding is written to
+   CONTENTS unless it is NULL.  Each address word is followed by as
+   many bitmap words as are needed to cover the addresses after it.
+   Bit 0 of a bitmap word is set to tell it apart from an address,
+   and bit N + 1 stands for the address N words past the end of the
+   words covered so far.  */
+
+static bfd_size_type
+elf_link_encode_relr (bfd *abfd, const bfd_vma *addrs,
+		      bfd_size_type count, unsigned int wordsize,
+		      bfd_byte *contents)
+{
+  unsigned int nbits = wordsize * 8 - 1;
+  bfd_size_type i, size;
+
+  size = 0;
+  i = 0;
+  while (i < count)
+    {
+      bfd_vma base;
+
+      if (contents != NULL)
+	bfd_put (wordsize * 8, abfd, addrs[i], contents + size);
+      size += wordsize;
+      base = addrs[i] + wordsize;
+      i++;
+
+      for (;;)
+	{
+	  bfd_vma bitmap = 0;
+
+	  for (; i < count; i++)
+	    {
+	      bfd_vma delta = addrs[i] - base;
+
+	      if (delta >= (bfd_vma) nbits * wordsize)
+		break;
+	      bitmap |= (bfd_vma) 1 << (delta / wordsize);
+	    }
+	  if (bitmap == 0)
+	    break;
+
+	  if (contents != NULL)
+	    bfd_put (wordsize * 8, abfd, (bitmap << 1) | 1,
+		     contents + size);
+	  size += wordsize;
+	  base += (bfd_vma) nbits * wordsize;
+	}
+    }
+
+  return size;
+}
+
+/* Set the size of the .relr.dyn section from the final addresses of
+   the relative relocations packed into it.  This is called from the
+   linker's layout loop once section addresses have been assigned,
+   and sets *NEED_LAYOUT if the size changed.  The section may shrink
+   from the backend's upper bound the first time only; after that it
+   only grows, so that layout converges, and bfd_elf_final_link pads
+   any unused space.  */
+
+bfd_boolean
+bfd_elf_size_relative_relocs (struct bfd_link_info *info,
+			      bfd_boolean *need_layout)
+{
+  struct elf_link_hash_table *htab;
+  const struct elf_backend_data *bed;
+  asection *s;
+  bfd_vma *addrs;
+  bfd_size_type count, size;
+
+  if (!is_elf_hash_table (info->hash))
+    return TRUE;
+
+  htab = elf_hash_table (info);
+  s = htab->srelrdyn;
+  if (s == NULL
+      || s->size == 0
+      || (s->flags & SEC_EXCLUDE) != 0
+      || bfd_is_abs_section (s->output_section))
+    return TRUE;
+
+  if (!elf_link_relr_addrs (info, &addrs, &count))
+    return FALSE;
+
+  bed = get_elf_backend_data (info->output_bfd);
+  size = elf_link_encode_relr (info->output_bfd, addrs, count,
+			       bed->s->arch_size / 8, NULL);
+  free (addrs);
+
+  if (size > s->size || (size < s->size && !htab->srelrdyn_sized))
+    {
+      s->size = size;
+      *need_layout = TRUE;
+    }
+  htab->srelrdyn_sized = TRUE;
+
+  return TRUE;
+}
+
+/* Write out the contents of the .relr.dyn section.  */
+
+static bfd_boolean
+elf_link_output_relative_relocs (struct bfd_link_info *info)
+{
+  struct elf_link_hash_table *htab = elf_hash_table (info);
+  const struct elf_backend_data *bed;
+  asection *s = htab->srelrdyn;
+  unsigned int wordsize;
+  bfd_vma *addrs;
+  bfd_size_type count, size;
+
+  if (!elf_link_relr_addrs (info, &addrs, &count))
+    return FALSE;
+
+  bed = get_elf_backend_data (info->output_bfd);
+  wordsize = bed->s->arch_size / 8;
+  size = elf_link_encode_relr (info->output_bfd, addrs, count, wordsize,
+			       NULL);
+  if (size > s->size)
+    {
+      _bfd_error_handler
+	/* xgettext:c-format */
+	(_("%pB: packed relative relocations need %#" PRIx64 " bytes"
+	   " but section `%pA' has %#" PRIx64),
+	 info->output_bfd, (uint64_t) size, s, (uint64_t) s->size);
+      free (addrs);
+      bfd_set_error (bfd_error_bad_value);
+      return FALSE;
+    }
+
+  s->contents = (bfd_byte *) bfd_alloc (s->owner, s->size);
+  if (s->contents == NULL)
+    {
+      free (addrs);
+      return FALSE;
+    }
+  elf_link_encode_relr (info->output_bfd, addrs, count, wordsize,
+			s->contents);
+  free (addrs);
+
+  /* Pad with empty bitmap words, which the dynamic linker skips.  */
+  for (; size < s->size; size += wordsize)
+    bfd_put (wordsize * 8, info->output_bfd, 1, s->contents + size);
+
+  return TRUE;
+}
+
 /* Do the final step of an ELF link.  */
 
 bfd_boolean
@@ -12412,7 +12724,7 @@ bfd_elf_final_link (bfd *abfd, struct bfd_link_info *info)
     }
 
   /* Finalize the .strtab section.  */
-  _bfd_elf_strtab_finalize (flinfo.symstrtab);
+  elf_link_strtab_finalize (info, flinfo.symstrtab);
 
   /* Swap out the .strtab section. */
   if (!elf_link_swap_symbols_out (&flinfo))
@@ -12500,6 +12812,12 @@ bfd_elf_final_link (bfd *abfd, struct bfd_link_info *info)
   if (dynamic && info->combreloc && dynobj != NULL)
     relativecount = elf_link_sort_relocs (abfd, info, &reldyn);
 
+  if (htab->srelrdyn != NULL
+      && htab->srelrdyn->size != 0
+      && (htab->srelrdyn->flags & SEC_EXCLUDE) == 0
+      && !elf_link_output_relative_relocs (info))
+    goto error_return;
+
   /* If we are linking against a dynamic object, or generating a
      shared library, finish up the dynamic linking information.  */
   if (dynamic)
@@ -12644,6 +12962,15 @@ bfd_elf_final_link (bfd *abfd, struct bfd_link_info *info)
 	      dyn.d_un.d_ptr = o->output_section->vma + o->output_offset;
 	      break;
 
+	    case DT_RELR:
+	      o = htab->srelrdyn;
+	      dyn.d_un.d_ptr = o->output_section->vma + o->output_offset;
+	      break;
+
+	    case DT_RELRSZ:
+	      dyn.d_un.d_val = htab->srelrdyn->size;
+	      break;
+
 	    case DT_REL:
 	    case DT_RELA:
 	    case DT_RELSZ:
@@ -13096,70 +13423,314 @@ _bfd_elf_gc_mark_reloc (struct bfd_link_info *info,
   return TRUE;
 }
 
+/* A section in the stack of sections that _bfd_elf_gc_mark has
+   marked but not yet finished following.  */
+
+struct elf_gc_mark_frame
+{
+  struct elf_gc_mark_frame *next;
+  asection *sec;
+  /* How far we have got through SEC.  */
+  enum
+    {
+      gc_mark_group,
+      gc_mark_relocs,
+      gc_mark_fdes,
+      gc_mark_done
+    } state;
+  /* Whether COOKIE has been set up for SEC's relocs.  */
+  bfd_boolean have_cookie;
+  struct elf_reloc_cookie cookie;
+  /* When following a __start_XXX or __stop_XXX reference, the next
+     XXX section to mark.  */
+  asection *start_stop_sec;
+};
+
+/* Local symbols or relocs that _bfd_elf_gc_mark has cached while
+   marking.  SEC is NULL for the local symbols of ABFD, otherwise the
+   section whose relocs are cached.  */
+
+struct elf_gc_mark_cached
+{
+  struct elf_gc_mark_cached *next;
+  bfd *abfd;
+  asection *sec;
+};
+
+/* Set up COOKIE for the relocs of SEC.  When we are not keeping
+   memory, init_reloc_cookie reads a private copy of the local symbols
+   for every cookie, and every section waiting on the mark stack holds
+   one.  Instead cache the first copy read for each bfd in its symtab
+   header, recording it on SHARED so the copy can be released once
+   marking is done.  If KEEP_RELS, do the same for the relocs of SEC;
+   .eh_frame relocs are wanted again for every section with FDEs.  */
+
+static bfd_boolean
+elf_gc_mark_init_cookie (struct elf_reloc_cookie *cookie,
+			 struct bfd_link_info *info, asection *sec,
+			 bfd_boolean keep_rels,
+			 struct elf_gc_mark_cached **shared)
+{
+  Elf_Internal_Shdr *symtab_hdr;
+  struct elf_gc_mark_cached *ent;
+
+  if (!init_reloc_cookie_for_section (cookie, info, sec))
+    return FALSE;
+
+  symtab_hdr = &elf_tdata (sec->owner)->symtab_hdr;
+  if (cookie->locsyms != NULL && symtab_hdr->contents == NULL)
+    {
+      ent = (struct elf_gc_mark_cached *) bfd_malloc (sizeof (*ent));
+      if (ent != NULL)
+	{
+	  ent->abfd = sec->owner;
+	  ent->sec = NULL;
+	  ent->next = *shared;
+	  *shared = ent;
+	  symtab_hdr->contents = (unsigned char *) cookie->locsyms;
+	}
+    }
+  if (keep_rels
+      && cookie->rels != NULL
+      && elf_section_data (sec)->relocs == NULL)
+    {
+      ent = (struct elf_gc_mark_cached *) bfd_malloc (sizeof (*ent));
+      if (ent != NULL)
+	{
+	  ent->abfd = sec->owner;
+	  ent->sec = sec;
+	  ent->next = *shared;
+	  *shared = ent;
+	  elf_section_data (sec)->relocs = cookie->rels;
+	}
+    }
+  return TRUE;
+}
+
+/* Mark SEC and push it on STACK, reusing a frame from FREE_LIST if
+   there is one.  */
+
+static bfd_boolean
+elf_gc_mark_push (struct elf_gc_mark_frame **stack,
+		  struct elf_gc_mark_frame **free_list,
+		  asection *sec)
+{
+  struct elf_gc_mark_frame *frame;
+
+  frame = *free_list;
+  if (frame != NULL)
+    *free_list = frame->next;
+  else
+    {
+      frame = (struct elf_gc_mark_frame *) bfd_malloc (sizeof (*frame));
+      if (frame == NULL)
+	return FALSE;
+    }
+
+  sec->gc_mark = 1;
+  frame->sec = sec;
+  frame->state = gc_mark_group;
+  frame->have_cookie = FALSE;
+  frame->start_stop_sec = NULL;
+  frame->next = *stack;
+  *stack = frame;
+  return TRUE;
+}
+
+/* Mark RSEC, a section referenced from the section being processed.
+   Return TRUE if RSEC needs its own references followed, in which
+   case it has been pushed on STACK.  */
+
+static bfd_boolean
+elf_gc_mark_ref (struct elf_gc_mark_frame **stack,
+		 struct elf_gc_mark_frame **free_list,
+		 asection *rsec, bfd_boolean *ok)
+{
+  if (rsec->gc_mark)
+    return FALSE;
+  if (bfd_get_flavour (rsec->owner) != bfd_target_elf_flavour
+      || (rsec->owner->flags & DYNAMIC) != 0)
+    {
+      rsec->gc_mark = 1;
+      return FALSE;
+    }
+  if (!elf_gc_mark_push (stack, free_list, rsec))
+    {
+      *ok = FALSE;
+      return FALSE;
+    }
+  return TRUE;
+}
+
 /* The mark phase of garbage collection.  For a given section, mark
    it and any sections in this section's group, and all the sections
-   which define symbols to which it refers.  */
+   which define symbols to which it refers.
+
+   Sections are visited depth first in the same order as a recursive
+   walk would, but using a heap-allocated stack so that long chains
+   of references do not exhaust the C stack.  */
 
 bfd_boolean
 _bfd_elf_gc_mark (struct bfd_link_info *info,
 		  asection *sec,
 		  elf_gc_mark_hook_fn gc_mark_hook)
 {
-  bfd_boolean ret;
-  asection *group_sec, *eh_frame;
-
-  sec->gc_mark = 1;
+  struct elf_gc_mark_frame *stack = NULL;
+  struct elf_gc_mark_frame *free_list = NULL;
+  struct elf_gc_mark_frame *frame;
+  struct elf_gc_mark_cached *shared = NULL;
+  bfd_boolean ok = TRUE;
 
-  /* Mark all the sections in the group.  */
-  group_sec = elf_section_data (sec)->next_in_group;
-  if (group_sec && !group_sec->gc_mark)
-    if (!_bfd_elf_gc_mark (info, group_sec, gc_mark_hook))
-      return FALSE;
+  if (!elf_gc_mark_push (&stack, &free_list, sec))
+    return FALSE;
 
-  /* Look through the section relocs.  */
-  ret = TRUE;
-  eh_frame = elf_eh_frame_section (sec->owner);
-  if ((sec->flags & SEC_RELOC) != 0
-      && sec->reloc_count > 0
-      && sec != eh_frame)
+  while (ok && (frame = stack) != NULL)
     {
-      struct elf_reloc_cookie cookie;
+      asection *group_sec, *eh_frame;
 
-      if (!init_reloc_cookie_for_section (&cookie, info, sec))
-	ret = FALSE;
-      else
+      switch (frame->state)
 	{
-	  for (; cookie.rel < cookie.relend; cookie.rel++)
-	    if (!_bfd_elf_gc_mark_reloc (info, sec, gc_mark_hook, &cookie))
-	      {
-		ret = FALSE;
+	case gc_mark_group:
+	  /* Mark all the sections in the group.  */
+	  frame->state = gc_mark_relocs;
+	  group_sec = elf_section_data (frame->sec)->next_in_group;
+	  if (group_sec && !group_sec->gc_mark)
+	    {
+	      ok = elf_gc_mark_push (&stack, &free_list, group_sec);
+	      break;
+	    }
+	  /* Fall through.  */
+
+	case gc_mark_relocs:
+	  /* Look through the section relocs.  */
+	  if (!frame->have_cookie)
+	    {
+	      eh_frame = elf_eh_frame_section (frame->sec->owner);
+	      if ((frame->sec->flags & SEC_RELOC) == 0
+		  || frame->sec->reloc_count == 0
+		  || frame->sec == eh_frame)
+		{
+		  frame->state = gc_mark_fdes;
+		  continue;
+		}
+	      if (!elf_gc_mark_init_cookie (&frame->cookie, info,
+					    frame->sec, FALSE, &shared))
+		{
+		  ok = FALSE;
+		  break;
+		}
+	      frame->have_cookie = TRUE;
+	    }
+
+	  while (frame->start_stop_sec != NULL
+		 || frame->cookie.rel < frame->cookie.relend)
+	    {
+	      asection *rsec;
+	      bfd_boolean start_stop = FALSE;
+
+	      if (frame->start_stop_sec != NULL)
+		{
+		  rsec = frame->start_stop_sec;
+		  start_stop = TRUE;
+		}
+	      else
+		{
+		  rsec = _bfd_elf_gc_mark_rsec (info, frame->sec,
+						gc_mark_hook,
+						&frame->cookie, &start_stop);
+		  frame->cookie.rel++;
+		}
+
+	      frame->start_stop_sec = NULL;
+	      if (rsec == NULL)
+		continue;
+	      if (start_stop)
+		frame->start_stop_sec
+		  = bfd_get_next_section_by_name (rsec->owner, rsec);
+	      if (elf_gc_mark_ref (&stack, &free_list, rsec, &ok) || !ok)
 		break;
-	      }
-	  fini_reloc_cookie_for_section (&cookie, sec);
+	    }
+	  if (stack != frame || !ok)
+	    break;
+
+	  fini_reloc_cookie_for_section (&frame->cookie, frame->sec);
+	  frame->have_cookie = FALSE;
+	  frame->state = gc_mark_fdes;
+	  /* Fall through.  */
+
+	case gc_mark_fdes:
+	  frame->state = gc_mark_done;
+	  eh_frame = elf_eh_frame_section (frame->sec->owner);
+	  if (eh_frame && elf_fde_list (frame->sec))
+	    {
+	      struct elf_reloc_cookie cookie;
+
+	      /* FDE marking goes through _bfd_elf_gc_mark_reloc, which
+		 calls back into this function with a stack of its own.  */
+	      if (!elf_gc_mark_init_cookie (&cookie, info, eh_frame, TRUE,
+					    &shared))
+		ok = FALSE;
+	      else
+		{
+		  if (!_bfd_elf_gc_mark_fdes (info, frame->sec, eh_frame,
+					      gc_mark_hook, &cookie))
+		    ok = FALSE;
+		  fini_reloc_cookie_for_section (&cookie, eh_frame);
+		}
+	      if (!ok)
+		break;
+	    }
+
+	  eh_frame = elf_section_eh_frame_entry (frame->sec);
+	  if (eh_frame && !eh_frame->gc_mark)
+	    {
+	      ok = elf_gc_mark_push (&stack, &free_list, eh_frame);
+	      break;
+	    }
+	  /* Fall through.  */
+
+	case gc_mark_done:
+	  stack = frame->next;
+	  frame->next = free_list;
+	  free_list = frame;
+	  break;
 	}
     }
 
-  if (ret && eh_frame && elf_fde_list (sec))
+  while ((frame = stack) != NULL)
     {
-      struct elf_reloc_cookie cookie;
+      if (frame->have_cookie)
+	fini_reloc_cookie_for_section (&frame->cookie, frame->sec);
+      stack = frame->next;
+      frame->next = free_list;
+      free_list = frame;
+    }
+  while ((frame = free_list) != NULL)
+    {
+      free_list = frame->next;
+      free (frame);
+    }
+  while (shared != NULL)
+    {
+      struct elf_gc_mark_cached *ent = shared;
 
-      if (!init_reloc_cookie_for_section (&cookie, info, eh_frame))
-	ret = FALSE;
+      if (ent->sec != NULL)
+	{
+	  free (elf_section_data (ent->sec)->relocs);
+	  elf_section_data (ent->sec)->relocs = NULL;
+	}
       else
 	{
-	  if (!_bfd_elf_gc_mark_fdes (info, sec, eh_frame,
-				      gc_mark_hook, &cookie))
-	    ret = FALSE;
-	  fini_reloc_cookie_for_section (&cookie, eh_frame);
+	  Elf_Internal_Shdr *symtab_hdr = &elf_tdata (ent->abfd)->symtab_hdr;
+
+	  free (symtab_hdr->contents);
+	  symtab_hdr->contents = NULL;
 	}
+      shared = ent->next;
+      free (ent);
     }
 
-  eh_frame = elf_section_eh_frame_entry (sec);
-  if (ret && eh_frame && !eh_frame->gc_mark)
-    if (!_bfd_elf_gc_mark (info, eh_frame, gc_mark_hook))
-      ret = FALSE;
-
-  return ret;
+  return ok;
 }
 
 /* Scan and mark sections in a special or debug section group.  */
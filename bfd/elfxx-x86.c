@@ -734,6 +734,8 @@ elf_x86_link_hash_table_free (bfd *obfd)
     htab_delete (htab->loc_hash_table);
   if (htab->loc_hash_memory)
     objalloc_free ((struct objalloc *) htab->loc_hash_memory);
+  if (htab->relative_reloc)
+    free (htab->relative_reloc);
   _bfd_elf_link_hash_table_free (obfd);
 }
 
@@ -952,6 +954,248 @@ _bfd_x86_elf_link_check_relocs (bfd *abfd, struct bfd_link_info *info)
   return _bfd_elf_link_check_relocs (abfd, info);
 }
 
+/* Compare two relative relocations by input section id and offset.  */
+
+static int
+elf_x86_relative_reloc_cmp (const void *a, const void *b)
+{
+  const struct elf_x86_relative_reloc *ra
+    = (const struct elf_x86_relative_reloc *) a;
+  const struct elf_x86_relative_reloc *rb
+    = (const struct elf_x86_relative_reloc *) b;
+
+  if (ra->sec->id != rb->sec->id)
+    return ra->sec->id < rb->sec->id ? -1 : 1;
+  if (ra->offset != rb->offset)
+    return ra->offset < rb->offset ? -1 : 1;
+  return 0;
+}
+
+/* Return TRUE if relocation REL in a section of ABFD will become a
+   relative relocation in its dynamic reloc section, which is the case
+   for a pointer sized relocation against a symbol that is resolved
+   locally.  This must agree with what relocate_section does; it may
+   only err on the side of returning FALSE.  */
+
+static bfd_boolean
+elf_x86_relative_reloc_p (bfd *abfd, struct bfd_link_info *info,
+			  struct elf_x86_link_hash_table *htab,
+			  const Elf_Internal_Rela *rel)
+{
+  Elf_Internal_Shdr *symtab_hdr = &elf_symtab_hdr (abfd);
+  unsigned int r_symndx = htab->r_sym (rel->r_info);
+  unsigned int r_type = (ABI_64_P (abfd)
+			 ? ELF64_R_TYPE (rel->r_info)
+			 : ELF32_R_TYPE (rel->r_info));
+  asection *sym_sec;
+
+  if (r_type != htab->pointer_r_type
+      || rel->r_offset % htab->got_entry_size != 0)
+    return FALSE;
+
+  if (r_symndx < symtab_hdr->sh_info)
+    {
+      Elf_Internal_Sym *isym;
+
+      isym = bfd_sym_from_r_symndx (&htab->sym_cache, abfd, r_symndx);
+      if (isym == NULL
+	  || ELF_ST_TYPE (isym->st_info) == STT_GNU_IFUNC
+	  || ELF_ST_TYPE (isym->st_info) == STT_TLS)
+	return FALSE;
+      sym_sec = bfd_section_from_elf_index (abfd, isym->st_shndx);
+    }
+  else
+    {
+      struct elf_link_hash_entry *h;
+
+      h = elf_sym_hashes (abfd)[r_symndx - symtab_hdr->sh_info];
+      while (h->root.type == bfd_link_hash_indirect
+	     || h->root.type == bfd_link_hash_warning)
+	h = (struct elf_link_hash_entry *) h->root.u.i.link;
+
+      /* Like COPY_INPUT_RELOC_P for a symbol defined here.  */
+      if ((h->root.type != bfd_link_hash_defined
+	   && h->root.type != bfd_link_hash_defweak)
+	  || h->type == STT_GNU_IFUNC
+	  || h->type == STT_TLS
+	  || !h->def_regular
+	  || (h->dynindx != -1
+	      && !(bfd_link_executable (info) || SYMBOLIC_BIND (info, h))))
+	return FALSE;
+      sym_sec = h->root.u.def.section;
+    }
+
+  return (sym_sec != NULL
+	  && !bfd_is_abs_section (sym_sec)
+	  && !bfd_is_und_section (sym_sec)
+	  && !bfd_is_com_section (sym_sec)
+	  && !discarded_section (sym_sec));
+}
+
+/* Move the relative relocations in writable sections from their
+   dynamic reloc sections to .relr.dyn, and set an upper bound on the
+   size of .relr.dyn.  */
+
+static bfd_boolean
+elf_x86_size_relative_relocs (struct bfd_link_info *info,
+			      struct elf_x86_link_hash_table *htab)
+{
+  asection *srelrdyn = htab->elf.srelrdyn;
+  bfd_size_type count, alloc, i, j;
+  struct elf_x86_relative_reloc *relocs;
+  bfd *ibfd;
+
+  count = 0;
+  alloc = 0;
+  relocs = NULL;
+  for (ibfd = info->input_bfds; ibfd != NULL; ibfd = ibfd->link.next)
+    {
+      asection *sec;
+
+      if (! is_x86_elf (ibfd, htab))
+	continue;
+
+      for (sec = ibfd->sections; sec != NULL; sec = sec->next)
+	{
+	  Elf_Internal_Rela *internal_relocs, *rel, *relend;
+
+	  if ((sec->flags & (SEC_ALLOC | SEC_RELOC | SEC_EXCLUDE))
+	      != (SEC_ALLOC | SEC_RELOC)
+	      || sec->reloc_count == 0
+	      || discarded_section (sec)
+	      || sec->sec_info_type != SEC_INFO_TYPE_NONE
+	      || elf_section_data (sec)->sreloc == NULL
+	      || (sec->output_section->flags & SEC_READONLY) != 0
+	      || ((bfd_vma) 1 << sec->alignment_power) < htab->got_entry_size)
+	    continue;
+
+	  internal_relocs = _bfd_elf_link_read_relocs (ibfd, sec, NULL,
+						       NULL,
+						       info->keep_memory);
+	  if (internal_relocs == NULL)
+	    goto error_return;
+
+	  relend = internal_relocs + sec->reloc_count;
+	  for (rel = internal_relocs; rel < relend; rel++)
+	    {
+	      if (!elf_x86_relative_reloc_p (ibfd, info, htab, rel))
+		continue;
+
+	      if (count == alloc)
+		{
+		  struct elf_x86_relative_reloc *n;
+
+		  alloc = alloc == 0 ? 64 : alloc * 2;
+		  n = (struct elf_x86_relative_reloc *)
+		    bfd_realloc (relocs, alloc * sizeof (*relocs));
+		  if (n == NULL)
+		    {
+		      if (elf_section_data (sec)->relocs != internal_relocs)
+			free (internal_relocs);
+		      goto error_return;
+		    }
+		  relocs = n;
+		}
+	      relocs[count].sec = sec;
+	      relocs[count].offset = rel->r_offset;
+	      count++;
+	    }
+
+	  if (elf_section_data (sec)->relocs != internal_relocs)
+	    free (internal_relocs);
+	}
+    }
+
+  if (count != 0)
+    qsort (relocs, count, sizeof (*relocs), elf_x86_relative_reloc_cmp);
+
+  /* Leave relocations sharing an offset where they are, and take the
+     space of the others out of their dynamic reloc sections.  */
+  j = 0;
+  for (i = 0; i < count; )
+    {
+      bfd_size_type k = i + 1;
+
+      while (k < count
+	     && elf_x86_relative_reloc_cmp (&relocs[i], &relocs[k]) == 0)
+	k++;
+      if (k == i + 1)
+	{
+	  elf_section_data (relocs[i].sec)->sreloc->size
+	    -= htab->sizeof_reloc;
+	  relocs[j++] = relocs[i];
+	}
+      i = k;
+    }
+
+  htab->relative_reloc = relocs;
+  htab->relative_reloc_count = j;
+  srelrdyn->size = j * htab->got_entry_size;
+  return TRUE;
+
+ error_return:
+  if (relocs != NULL)
+    free (relocs);
+  return FALSE;
+}
+
+/* Return TRUE if the relocation at OFFSET in SEC has been moved to
+   .relr.dyn, and count it as done.  */
+
+bfd_boolean
+_bfd_x86_elf_packed_relative_reloc_p (struct elf_x86_link_hash_table *htab,
+				      asection *sec, bfd_vma offset)
+{
+  struct elf_x86_relative_reloc key;
+
+  if (htab->relative_reloc_count == 0)
+    return FALSE;
+
+  key.sec = sec;
+  key.offset = offset;
+  if (bsearch (&key, htab->relative_reloc, htab->relative_reloc_count,
+	       sizeof (key), elf_x86_relative_reloc_cmp) == NULL)
+    return FALSE;
+
+  htab->relative_reloc_done++;
+  return TRUE;
+}
+
+/* Return the addresses of the relocations moved to .relr.dyn.  This
+   is the elf_backend_relative_relocs hook.  */
+
+bfd_boolean
+_bfd_x86_elf_relative_relocs (struct bfd_link_info *info,
+			      bfd_vma **paddrs, bfd_size_type *pcount)
+{
+  struct elf_x86_link_hash_table *htab;
+  const struct elf_backend_data *bed;
+  bfd_vma *addrs;
+  bfd_size_type i;
+
+  bed = get_elf_backend_data (info->output_bfd);
+  htab = elf_x86_hash_table (info, bed->target_id);
+  if (htab == NULL)
+    return FALSE;
+
+  addrs = (bfd_vma *) bfd_malloc ((htab->relative_reloc_count + 1)
+				  * sizeof (*addrs));
+  if (addrs == NULL)
+    return FALSE;
+
+  for (i = 0; i < htab->relative_reloc_count; i++)
+    {
+      asection *sec = htab->relative_reloc[i].sec;
+
+      addrs[i] = (sec->output_section->vma + sec->output_offset
+		  + htab->relative_reloc[i].offset);
+    }
+
+  *paddrs = addrs;
+  *pcount = htab->relative_reloc_count;
+  return TRUE;
+}
+
 /* Set the sizes of the dynamic sections.  */
 
 bfd_boolean
@@ -1203,6 +1447,10 @@ _bfd_x86_elf_size_dynamic_sections (bfd *output_bfd,
 	  = htab->non_lazy_plt->eh_frame_plt_size;
     }
 
+  if (htab->elf.srelrdyn != NULL
+      && !elf_x86_size_relative_relocs (info, htab))
+    return FALSE;
+
   /* We now have determined the sizes of the various dynamic sections.
      Allocate memory for them.  */
   relocs = FALSE;
@@ -434,6 +434,16 @@ enum elf_x86_target_os
   is_nacl
 };
 
+/* A relative relocation moved from a dynamic reloc section to
+   .relr.dyn.  */
+
+struct elf_x86_relative_reloc
+{
+  /* The input section and the offset within it.  */
+  asection *sec;
+  bfd_vma offset;
+};
+
 /* x86 ELF linker hash table.  */
 
 struct elf_x86_link_hash_table
@@ -503,6 +513,13 @@ struct elf_x86_link_hash_table
      yet.  This is only used for x86-64.  */
   bfd_vma tlsdesc_plt;
 
+  /* Relative relocations moved to .relr.dyn, sorted by input section
+     id and offset, their number and how many of them have been
+     relocated.  This is only used for x86-64.  */
+  struct elf_x86_relative_reloc *relative_reloc;
+  bfd_size_type relative_reloc_count;
+  bfd_size_type relative_reloc_done;
+
    /* Value used to fill the unused bytes of the first PLT entry.  This
       is only used for i386.  */
   bfd_byte plt0_pad_byte;
@@ -655,6 +672,12 @@ extern bfd_boolean _bfd_x86_elf_link_check_relocs
 extern bfd_boolean _bfd_x86_elf_size_dynamic_sections
   (bfd *, struct bfd_link_info *);
 
+extern bfd_boolean _bfd_x86_elf_relative_relocs
+  (struct bfd_link_info *, bfd_vma **, bfd_size_type *);
+
+extern bfd_boolean _bfd_x86_elf_packed_relative_reloc_p
+  (struct elf_x86_link_hash_table *, asection *, bfd_vma);
+
 extern struct elf_x86_link_hash_table *_bfd_x86_elf_finish_dynamic_sections
   (bfd *, struct bfd_link_info *);
 
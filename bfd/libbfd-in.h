@@ -90,6 +90,10 @@ struct artdata
   file_ptr armap_datepos;	/* Position within archive to seek to
 				   rewrite the date field.  */
   void *tdata;			/* Backend specific information.  */
+  /* Member ordinal of each symdef, built on demand by
+     _bfd_archive_index_symdefs.  */
+  unsigned int *symdef_member;
+  unsigned int member_count;	/* Number of distinct members in it.  */
 };
 
 #define bfd_ardata(bfd) ((bfd)->tdata.aout_ar_data)
@@ -138,6 +142,8 @@ extern bfd * _bfd_look_for_bfd_in_cache
   (bfd *, file_ptr) ATTRIBUTE_HIDDEN;
 extern bfd_boolean _bfd_add_bfd_to_archive_cache
   (bfd *, file_ptr, bfd *) ATTRIBUTE_HIDDEN;
+extern bfd_boolean _bfd_archive_index_symdefs
+  (bfd *) ATTRIBUTE_HIDDEN;
 extern bfd_boolean _bfd_generic_mkarchive
   (bfd *) ATTRIBUTE_HIDDEN;
 extern char *_bfd_append_relative_path
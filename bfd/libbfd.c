@@ -969,13 +969,12 @@ _bfd_generic_get_section_contents (bfd *abfd,
 
 bfd_boolean
 _bfd_generic_get_section_contents_in_window
-  (bfd *abfd ATTRIBUTE_UNUSED,
-   sec_ptr section ATTRIBUTE_UNUSED,
-   bfd_window *w ATTRIBUTE_UNUSED,
-   file_ptr offset ATTRIBUTE_UNUSED,
-   bfd_size_type count ATTRIBUTE_UNUSED)
+  (bfd *abfd,
+   sec_ptr section,
+   bfd_window *w,
+   file_ptr offset,
+   bfd_size_type count)
 {
-#ifdef USE_MMAP
   bfd_size_type sz;
 
   if (count == 0)
@@ -1019,9 +1018,6 @@ _bfd_generic_get_section_contents_in_window
 				TRUE))
     return FALSE;
   return TRUE;
-#else
-  abort ();
-#endif
 }
 
 /* This generic function can only be used in implementations where creating
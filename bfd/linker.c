@@ -913,6 +913,8 @@ _bfd_generic_link_add_archive_symbols
   bfd_boolean loop;
   bfd_size_type amt;
   unsigned char *included;
+  unsigned char *member_included;
+  unsigned int *symdef_member;
 
   if (! bfd_has_map (abfd))
     {
@@ -923,13 +925,21 @@ _bfd_generic_link_add_archive_symbols
       return FALSE;
     }
 
-  amt = bfd_ardata (abfd)->symdef_count;
-  if (amt == 0)
+  if (bfd_ardata (abfd)->symdef_count == 0)
     return TRUE;
-  amt *= sizeof (*included);
+  if (!_bfd_archive_index_symdefs (abfd))
+    return FALSE;
+  symdef_member = bfd_ardata (abfd)->symdef_member;
+
+  /* INCLUDED has one flag per armap symbol, set once the symbol is
+     known to be defined, followed by one flag per archive member, set
+     once the member has been pulled in.  */
+  amt = bfd_ardata (abfd)->symdef_count;
+  amt += bfd_ardata (abfd)->member_count;
   included = (unsigned char *) bfd_zmalloc (amt);
   if (included == NULL)
     return FALSE;
+  member_included = included + bfd_ardata (abfd)->symdef_count;
 
   do
     {
@@ -949,13 +959,8 @@ _bfd_generic_link_add_archive_symbols
 	  struct bfd_link_hash_entry *h;
 	  struct bfd_link_hash_entry *undefs_tail;
 
-	  if (included[indx])
+	  if (included[indx] || member_included[symdef_member[indx]])
 	    continue;
-	  if (needed && arsym->file_offset == last_ar_offset)
-	    {
-	      included[indx] = 1;
-	      continue;
-	    }
 
 	  if (arsym->name == NULL)
 	    goto error_return;
@@ -998,19 +1003,8 @@ _bfd_generic_link_add_archive_symbols
 
 	  if (needed)
 	    {
-	      unsigned int mark;
-
-	      /* Look backward to mark all symbols from this object file
-		 which we have already seen in this pass.  */
-	      mark = indx;
-	      do
-		{
-		  included[mark] = 1;
-		  if (mark == 0)
-		    break;
-		  --mark;
-		}
-	      while (arsyms[mark].file_offset == last_ar_offset);
+	      /* Don't look at any symbol from this object file again.  */
+	      member_included[symdef_member[indx]] = 1;
 
 	      if (undefs_tail != info->hash->undefs_tail)
 		loop = TRUE;
@@ -26,14 +26,18 @@
    addr2line [options] addr addr ...
    or
    addr2line [options]
+   or
+   addr2line --batch [options]
 
-   both forms write results to stdout, the second form reads addresses
-   to be converted from stdin.  */
+   all forms write results to stdout, the second form reads addresses
+   to be converted from stdin, and the third reads lines of the form
+   "file addr addr ..." from stdin.  */
 
 #include "sysdep.h"
 #include "bfd.h"
 #include "getopt.h"
 #include "libiberty.h"
+#include "safe-ctype.h"
 #include "demangle.h"
 #include "bucomm.h"
 #include "elf-bfd.h"
@@ -44,6 +48,7 @@ static bfd_boolean with_functions;	/* -f, show function names.  */
 static bfd_boolean do_demangle;		/* -C, demangle names.  */
 static bfd_boolean pretty_print;	/* -p, print on one line.  */
 static bfd_boolean base_names;		/* -s, strip directory names.  */
+static bfd_boolean batch_mode;		/* --batch, read files from stdin.  */
 
 /* Flags passed to the name demangler.  */
 static int demangle_flags = DMGL_PARAMS | DMGL_ANSI;
@@ -53,10 +58,38 @@ static char **addr;		/* Hex addresses to process.  */
 
 static asymbol **syms;		/* Symbol table.  */
 
+/* A file that addresses are being translated for.  */
+
+struct addr2line_file
+{
+  struct addr2line_file *next;
+  char *name;
+  bfd *abfd;
+  asymbol **syms;
+  /* The section given by -j, or NULL.  */
+  asection *section;
+  /* The allocated sections of ABFD sorted by address, and for each
+     the highest address covered by it or any section before it.  */
+  asection **sorted;
+  bfd_vma *max_last;
+  unsigned int sorted_count;
+  /* Scratch space for the sections containing an address.  */
+  asection **hits;
+};
+
+/* Files kept open by --batch.  */
+static struct addr2line_file *open_files;
+
+enum command_line_switch
+{
+  OPTION_BATCH = 150
+};
+
 static struct option long_options[] =
 {
   {"addresses", no_argument, NULL, 'a'},
   {"basenames", no_argument, NULL, 's'},
+  {"batch", no_argument, NULL, OPTION_BATCH},
   {"demangle", optional_argument, NULL, 'C'},
   {"exe", required_argument, NULL, 'e'},
   {"functions", no_argument, NULL, 'f'},
@@ -77,7 +110,7 @@ static void usage (FILE *, int);
 static void slurp_symtab (bfd *);
 static void find_address_in_section (bfd *, asection *, void *);
 static void find_offset_in_section (bfd *, asection *);
-static void translate_addresses (bfd *, asection *);
+static void translate_addresses (struct addr2line_file *);
 
 /* Print a usage message to STREAM and exit with STATUS.  */
 
@@ -85,6 +118,7 @@ static void
 usage (FILE *stream, int status)
 {
   fprintf (stream, _("Usage: %s [option(s)] [addr(s)]\n"), program_name);
+  fprintf (stream, _("       %s --batch [option(s)]\n"), program_name);
   fprintf (stream, _(" Convert addresses into line number/file name pairs.\n"));
   fprintf (stream, _(" If no addresses are specified on the command line, they will be read from stdin\n"));
   fprintf (stream, _(" The options are:\n\
@@ -92,6 +126,7 @@ usage (FILE *stream, int status)
   -a --addresses         Show addresses\n\
   -b --target=<bfdname>  Set the binary file format\n\
   -e --exe=<executable>  Set the input file name (default is a.out)\n\
+     --batch             Read lines of the form \"<file> <addr>...\" from stdin\n\
   -i --inlines           Unwind inlined functions\n\
   -j --section=<name>    Read section-relative offsets instead of addresses\n\
   -p --pretty-print      Make the output easier to read for humans\n\
@@ -220,14 +255,111 @@ find_offset_in_section (bfd *abfd, asection *section)
                                                &line, &discriminator);
 }
 
+/* Qsort comparison function for addr2line_file.sorted.  */
+
+static int
+compare_section_vma (const void *a, const void *b)
+{
+  const asection *sa = *(const asection **) a;
+  const asection *sb = *(const asection **) b;
+
+  if (sa->vma != sb->vma)
+    return sa->vma < sb->vma ? -1 : 1;
+  return sa->index < sb->index ? -1 : sa->index > sb->index;
+}
+
+/* Build FILE's table of allocated sections sorted by address, so that
+   each address need not be checked against every section.  */
+
+static void
+build_section_table (struct addr2line_file *file)
+{
+  bfd *abfd = file->abfd;
+  asection *section;
+  unsigned int i, count;
+  bfd_vma max_last;
+
+  count = 0;
+  file->sorted = (asection **) xmalloc ((bfd_count_sections (abfd) + 1)
+					* sizeof (asection *));
+  for (section = abfd->sections; section != NULL; section = section->next)
+    if ((bfd_get_section_flags (abfd, section) & SEC_ALLOC) != 0
+	&& bfd_get_section_size (section) != 0)
+      file->sorted[count++] = section;
+
+  qsort (file->sorted, count, sizeof (asection *), compare_section_vma);
+
+  file->max_last = (bfd_vma *) xmalloc ((count + 1) * sizeof (bfd_vma));
+  max_last = 0;
+  for (i = 0; i < count; i++)
+    {
+      bfd_vma last = (bfd_get_section_vma (abfd, file->sorted[i])
+		      + bfd_get_section_size (file->sorted[i]) - 1);
+
+      if (i == 0 || last > max_last)
+	max_last = last;
+      file->max_last[i] = max_last;
+    }
+  file->sorted_count = count;
+  file->hits = (asection **) xmalloc ((count + 1) * sizeof (asection *));
+}
+
+/* Look for PC in the sections of FILE.  Sections are tried in the
+   same order as bfd_map_over_sections would, but only those that
+   contain PC are visited.  */
+
+static void
+find_address_in_file (struct addr2line_file *file)
+{
+  unsigned int lo, hi, nhits, i;
+
+  /* Find the first section starting above PC.  */
+  lo = 0;
+  hi = file->sorted_count;
+  while (lo < hi)
+    {
+      unsigned int mid = (lo + hi) / 2;
+
+      if (bfd_get_section_vma (file->abfd, file->sorted[mid]) <= pc)
+	lo = mid + 1;
+      else
+	hi = mid;
+    }
+
+  /* Collect the sections before it that reach PC.  */
+  nhits = 0;
+  while (lo > 0 && file->max_last[lo - 1] >= pc)
+    {
+      asection *section = file->sorted[--lo];
+      bfd_vma vma = bfd_get_section_vma (file->abfd, section);
+
+      if (pc - vma < bfd_get_section_size (section))
+	{
+	  /* Keep the hits in section order.  */
+	  for (i = nhits; i > 0 && file->hits[i - 1]->index > section->index;
+	       i--)
+	    file->hits[i] = file->hits[i - 1];
+	  file->hits[i] = section;
+	  nhits++;
+	}
+    }
+
+  for (i = 0; i < nhits && !found; i++)
+    find_address_in_section (file->abfd, file->hits[i], NULL);
+}
+
 /* Read hexadecimal addresses from stdin, translate into
    file_name:line_number and optionally function name.  */
 
 static void
-translate_addresses (bfd *abfd, asection *section)
+translate_addresses (struct addr2line_file *file)
 {
+  bfd *abfd = file->abfd;
+  asection *section = file->section;
   int read_stdin = (naddr == 0);
 
+  syms = file->syms;
+
   for (;;)
     {
       if (read_stdin)
@@ -271,7 +403,7 @@ translate_addresses (bfd *abfd, asection *section)
       if (section)
 	find_offset_in_section (abfd, section);
       else
-	bfd_map_over_sections (abfd, find_address_in_section, NULL);
+	find_address_in_file (file);
 
       if (! found)
 	{
@@ -363,28 +495,37 @@ translate_addresses (bfd *abfd, asection *section)
     }
 }
 
-/* Process a file.  Returns an exit value for main().  */
+/* Open FILE_NAME and read its symbols.  Returns NULL, after
+   reporting the problem, if the file can not be used.  */
 
-static int
-process_file (const char *file_name, const char *section_name,
-	      const char *target)
+static struct addr2line_file *
+open_file (const char *file_name, const char *section_name,
+	   const char *target)
 {
+  struct addr2line_file *file;
   bfd *abfd;
   asection *section;
   char **matching;
 
   if (get_file_size (file_name) < 1)
-    return 1;
+    return NULL;
 
   abfd = bfd_openr (file_name, target);
   if (abfd == NULL)
-    bfd_fatal (file_name);
+    {
+      bfd_nonfatal (file_name);
+      return NULL;
+    }
 
   /* Decompress sections.  */
   abfd->flags |= BFD_DECOMPRESS;
 
   if (bfd_check_format (abfd, bfd_archive))
-    fatal (_("%s: cannot get addresses from archive"), file_name);
+    {
+      non_fatal (_("%s: cannot get addresses from archive"), file_name);
+      bfd_close (abfd);
+      return NULL;
+    }
 
   if (! bfd_check_format_matches (abfd, bfd_object, &matching))
     {
@@ -394,31 +535,189 @@ process_file (const char *file_name, const char *section_name,
 	  list_matching_formats (matching);
 	  free (matching);
 	}
-      xexit (1);
+      bfd_close (abfd);
+      return NULL;
     }
 
   if (section_name != NULL)
     {
       section = bfd_get_section_by_name (abfd, section_name);
       if (section == NULL)
-	fatal (_("%s: cannot find section %s"), file_name, section_name);
+	{
+	  non_fatal (_("%s: cannot find section %s"), file_name,
+		     section_name);
+	  bfd_close (abfd);
+	  return NULL;
+	}
     }
   else
     section = NULL;
 
   slurp_symtab (abfd);
 
-  translate_addresses (abfd, section);
+  file = (struct addr2line_file *) xcalloc (1, sizeof (*file));
+  file->name = xstrdup (file_name);
+  file->abfd = abfd;
+  file->syms = syms;
+  file->section = section;
+  syms = NULL;
+  if (section == NULL)
+    build_section_table (file);
+
+  return file;
+}
+
+static void
+close_file (struct addr2line_file *file)
+{
+  if (file->syms != NULL)
+    free (file->syms);
+  if (file->sorted != NULL)
+    free (file->sorted);
+  if (file->max_last != NULL)
+    free (file->max_last);
+  if (file->hits != NULL)
+    free (file->hits);
+  bfd_close (file->abfd);
+  free (file->name);
+  free (file);
+}
+
+/* Process a file.  Returns an exit value for main().  */
 
-  if (syms != NULL)
+static int
+process_file (const char *file_name, const char *section_name,
+	      const char *target)
+{
+  struct addr2line_file *file;
+
+  file = open_file (file_name, section_name, target);
+  if (file == NULL)
+    return 1;
+
+  translate_addresses (file);
+
+  close_file (file);
+
+  return 0;
+}
+
+/* Read a line of any length from stdin into *BUF, which has *SIZE
+   bytes allocated.  Returns FALSE at end of file.  */
+
+static bfd_boolean
+read_line (char **buf, size_t *size)
+{
+  size_t len = 0;
+
+  for (;;)
     {
-      free (syms);
-      syms = NULL;
+      if (*size - len < 2)
+	{
+	  *size = *size * 2 + 128;
+	  *buf = (char *) xrealloc (*buf, *size);
+	}
+      if (fgets (*buf + len, *size - len, stdin) == NULL)
+	return len != 0;
+      len += strlen (*buf + len);
+      if (len != 0 && (*buf)[len - 1] == '\n')
+	return TRUE;
     }
+}
 
-  bfd_close (abfd);
+/* Handle --batch: read lines of the form "file addr addr ..." from
+   stdin and translate the addresses against the file, which is kept
+   open for later lines.  The output for each line is followed by an
+   empty line, so that a program driving addr2line through a pipe can
+   tell where it ends.  Returns an exit value for main().  */
 
-  return 0;
+static int
+process_batch (const char *section_name, const char *target)
+{
+  char *buf = NULL;
+  size_t size = 0;
+  char **args = NULL;
+  size_t args_size = 0;
+  int status = 0;
+
+  while (read_line (&buf, &size))
+    {
+      struct addr2line_file *file;
+      size_t nargs = 0;
+      char *p = buf;
+
+      /* Split the line into words.  */
+      for (;;)
+	{
+	  while (ISSPACE (*p))
+	    *p++ = '\0';
+	  if (*p == '\0')
+	    break;
+	  if (nargs == args_size)
+	    {
+	      args_size = args_size * 2 + 8;
+	      args = (char **) xrealloc (args, args_size * sizeof (char *));
+	    }
+	  args[nargs++] = p;
+	  while (*p != '\0' && !ISSPACE (*p))
+	    p++;
+	}
+
+      if (nargs == 0)
+	continue;
+
+      for (file = open_files; file != NULL; file = file->next)
+	if (strcmp (file->name, args[0]) == 0)
+	  break;
+      if (file == NULL)
+	{
+	  file = open_file (args[0], section_name, target);
+	  if (file != NULL)
+	    {
+	      file->next = open_files;
+	      open_files = file;
+	    }
+	}
+
+      if (file != NULL)
+	{
+	  if (nargs > 1)
+	    {
+	      addr = args + 1;
+	      naddr = nargs - 1;
+	      translate_addresses (file);
+	    }
+	}
+      else
+	{
+	  size_t i;
+
+	  status = 1;
+	  for (i = 1; i < nargs; i++)
+	    {
+	      if (with_addresses)
+		printf (pretty_print ? "%s: " : "%s\n", args[i]);
+	      if (with_functions)
+		printf (pretty_print ? "?? " : "??\n");
+	      printf ("??:0\n");
+	    }
+	}
+
+      printf ("\n");
+      fflush (stdout);
+    }
+
+  while (open_files != NULL)
+    {
+      struct addr2line_file *next = open_files->next;
+
+      close_file (open_files);
+      open_files = next;
+    }
+  free (args);
+  free (buf);
+
+  return status;
 }
 
 int
@@ -510,6 +809,9 @@ main (int argc, char **argv)
 	case 'j':
 	  section_name = optarg;
 	  break;
+	case OPTION_BATCH:
+	  batch_mode = TRUE;
+	  break;
 	default:
 	  usage (stderr, 1);
 	  break;
@@ -522,5 +824,12 @@ main (int argc, char **argv)
   addr = argv + optind;
   naddr = argc - optind;
 
+  if (batch_mode)
+    {
+      if (naddr != 0)
+	usage (stderr, 1);
+      return process_batch (section_name, target);
+    }
+
   return process_file (file_name, section_name, target);
 }
@@ -26,6 +26,7 @@
 #include "sysdep.h"
 #include "bfd.h"
 #include "libiberty.h"
+#include "hashtab.h"
 #include "progress.h"
 #include "getopt.h"
 #include "aout/ar.h"
@@ -1362,6 +1363,186 @@ move_members (bfd *arch, char **files_to_move)
   write_archive (arch);
 }
 
+/* An original member of an archive being updated by replace_members.
+   With 'r' and no positioning modifier, the file names on the command
+   line are looked up here rather than compared against every member,
+   which is quadratic in the size of large archives.  */
+
+struct replace_entry
+{
+  /* The member and the link that points at it.  */
+  bfd *member;
+  bfd **prev;
+  /* The normalized member name, and the next live member with the same
+     name in archive order.  */
+  const char *name;
+  struct replace_entry *next_same;
+};
+
+struct replace_index
+{
+  /* The first live member for each name.  */
+  htab_t by_name;
+  /* All members, keyed by bfd.  */
+  htab_t by_bfd;
+  /* The file names of the entries added so far.  */
+  htab_t added;
+  struct replace_entry *entries;
+};
+
+static hashval_t
+hash_replace_name (const void *p)
+{
+  const struct replace_entry *e = (const struct replace_entry *) p;
+
+  return filename_hash (e->name);
+}
+
+static int
+eq_replace_name (const void *p, const void *name)
+{
+  const struct replace_entry *e = (const struct replace_entry *) p;
+
+  return filename_eq (e->name, name);
+}
+
+static hashval_t
+hash_replace_bfd (const void *p)
+{
+  const struct replace_entry *e = (const struct replace_entry *) p;
+
+  return htab_hash_pointer (e->member);
+}
+
+static int
+eq_replace_bfd (const void *p, const void *abfd)
+{
+  const struct replace_entry *e = (const struct replace_entry *) p;
+
+  return e->member == abfd;
+}
+
+/* Index the members of ARCH.  */
+
+static void
+init_replace_index (struct replace_index *idx, bfd *arch)
+{
+  struct replace_entry **last_same;
+  struct replace_entry *e;
+  bfd **prev;
+  size_t count = 0;
+
+  for (prev = &arch->archive_next; *prev; prev = &(*prev)->archive_next)
+    count++;
+
+  idx->by_name = htab_create_alloc (count, hash_replace_name,
+				    eq_replace_name, NULL, xcalloc, free);
+  idx->by_bfd = htab_create_alloc (count, hash_replace_bfd,
+				   eq_replace_bfd, NULL, xcalloc, free);
+  idx->added = htab_create_alloc (16, filename_hash, filename_eq, NULL,
+				  xcalloc, free);
+  idx->entries = (struct replace_entry *) xmalloc (count * sizeof (*e));
+
+  e = idx->entries;
+  for (prev = &arch->archive_next; *prev; prev = &(*prev)->archive_next)
+    {
+      void **slot;
+
+      e->member = *prev;
+      e->prev = prev;
+      e->name = normalize (e->member->filename, arch);
+      e->next_same = NULL;
+
+      slot = htab_find_slot_with_hash (idx->by_bfd, e->member,
+				       htab_hash_pointer (e->member), INSERT);
+      *slot = e;
+
+      /* Chain members with the same name in archive order.  */
+      slot = htab_find_slot_with_hash (idx->by_name, e->name,
+				       filename_hash (e->name), INSERT);
+      if (*slot == NULL)
+	*slot = e;
+      else
+	{
+	  for (last_same = (struct replace_entry **) slot;
+	       *last_same != NULL;
+	       last_same = &(*last_same)->next_same)
+	    ;
+	  *last_same = e;
+	}
+      e++;
+    }
+}
+
+static void
+free_replace_index (struct replace_index *idx)
+{
+  htab_delete (idx->by_name);
+  htab_delete (idx->by_bfd);
+  htab_delete (idx->added);
+  free (idx->entries);
+}
+
+/* Return the first live member of the index named NAME, or NULL.  */
+
+static struct replace_entry *
+find_replace_entry (struct replace_index *idx, const char *name)
+{
+  return (struct replace_entry *) htab_find_with_hash (idx->by_name, name,
+						       filename_hash (name));
+}
+
+/* Record the entries inserted at SLOT, in front of NEXT.  */
+
+static void
+note_replace_added (struct replace_index *idx, bfd **slot, bfd *next)
+{
+  struct replace_entry *e;
+
+  for (; *slot != next; slot = &(*slot)->archive_next)
+    {
+      void **name_slot = htab_find_slot (idx->added, (*slot)->filename,
+					 INSERT);
+      if (*name_slot == NULL)
+	*name_slot = (void *) (*slot)->filename;
+    }
+
+  if (next != NULL)
+    {
+      e = (struct replace_entry *) htab_find_with_hash (idx->by_bfd, next,
+							htab_hash_pointer (next));
+      if (e != NULL)
+	e->prev = slot;
+    }
+}
+
+/* Remove the member E from the chain and from the index.  */
+
+static void
+remove_replace_entry (struct replace_index *idx, struct replace_entry *e)
+{
+  bfd *next = e->member->archive_next;
+  void **slot;
+
+  *e->prev = next;
+  if (next != NULL)
+    {
+      struct replace_entry *n;
+
+      n = (struct replace_entry *) htab_find_with_hash (idx->by_bfd, next,
+							htab_hash_pointer (next));
+      if (n != NULL)
+	n->prev = e->prev;
+    }
+
+  slot = htab_find_slot_with_hash (idx->by_name, e->name,
+				   filename_hash (e->name), NO_INSERT);
+  if (e->next_same != NULL)
+    *slot = e->next_same;
+  else
+    htab_clear_slot (idx->by_name, slot);
+}
+
 /* Ought to default to replacing in place, but this is existing practice!  */
 
 static void
@@ -1371,69 +1552,134 @@ replace_members (bfd *arch, char **files_to_move, bfd_boolean quick)
   bfd **after_bfd;		/* New entries go after this one.  */
   bfd *current;
   bfd **current_ptr;
+  bfd **tail = &arch->archive_next;
+  struct replace_index idx;
+  bfd_boolean indexed;
+
+  /* Elements of archives added to a thin archive are candidates for
+     replacement too; leave those to the simple search.  */
+  indexed = postype == pos_default && !quick && !make_thin_archive;
+  memset (&idx, 0, sizeof idx);
+  if (indexed)
+    init_replace_index (&idx, arch);
 
   while (files_to_move && *files_to_move)
     {
       if (! quick)
 	{
-	  current_ptr = &arch->archive_next;
-	  while (*current_ptr)
+	  const char *name = normalize (*files_to_move, arch);
+	  struct replace_entry *e = NULL;
+
+	  current = NULL;
+	  if (indexed)
 	    {
-	      current = *current_ptr;
+	      e = find_replace_entry (&idx, name);
+	      if (e != NULL)
+		{
+		  current = e->member;
+		  current_ptr = e->prev;
+		}
+	    }
+	  else
+	    {
+	      for (current_ptr = &arch->archive_next;
+		   *current_ptr;
+		   current_ptr = &(*current_ptr)->archive_next)
+		{
+		  /* For compatibility with existing ar programs, we
+		     permit the same file to be added multiple times.  */
+		  if (FILENAME_CMP (name,
+				    normalize ((*current_ptr)->filename,
+					       arch)) == 0
+		      && (*current_ptr)->arelt_data != NULL)
+		    {
+		      current = *current_ptr;
+		      break;
+		    }
+		}
+	    }
 
-	      /* For compatibility with existing ar programs, we
-		 permit the same file to be added multiple times.  */
-	      if (FILENAME_CMP (normalize (*files_to_move, arch),
-				normalize (current->filename, arch)) == 0
-		  && current->arelt_data != NULL)
+	  if (current != NULL)
+	    {
+	      bfd *next;
+
+	      if (newer_only)
 		{
-		  if (newer_only)
+		  struct stat fsbuf, asbuf;
+
+		  if (stat (*files_to_move, &fsbuf) != 0)
 		    {
-		      struct stat fsbuf, asbuf;
-
-		      if (stat (*files_to_move, &fsbuf) != 0)
-			{
-			  if (errno != ENOENT)
-			    bfd_fatal (*files_to_move);
-			  goto next_file;
-			}
-		      if (bfd_stat_arch_elt (current, &asbuf) != 0)
-			/* xgettext:c-format */
-			fatal (_("internal stat error on %s"),
-			       current->filename);
-
-		      if (fsbuf.st_mtime <= asbuf.st_mtime)
-			goto next_file;
+		      if (errno != ENOENT)
+			bfd_fatal (*files_to_move);
+		      goto next_file;
 		    }
+		  if (bfd_stat_arch_elt (current, &asbuf) != 0)
+		    /* xgettext:c-format */
+		    fatal (_("internal stat error on %s"),
+			   current->filename);
 
-		  after_bfd = get_pos_bfd (&arch->archive_next, pos_after,
-					   current->filename);
-		  if (ar_emul_replace (after_bfd, *files_to_move,
-				       target, verbose))
+		  if (fsbuf.st_mtime <= asbuf.st_mtime)
+		    goto next_file;
+		}
+
+	      /* The new entry goes after the first entry with this
+		 name, which is CURRENT itself unless an entry we added
+		 has the same name.  */
+	      if (indexed
+		  && htab_find (idx.added, current->filename) == NULL)
+		after_bfd = &current->archive_next;
+	      else
+		after_bfd = get_pos_bfd (&arch->archive_next, pos_after,
+					 current->filename);
+	      next = *after_bfd;
+	      if (ar_emul_replace (after_bfd, *files_to_move,
+				   target, verbose))
+		{
+		  /* Snip out this entry from the chain.  */
+		  if (indexed)
+		    {
+		      note_replace_added (&idx, after_bfd, next);
+		      if (tail == &current->archive_next)
+			tail = e->prev;
+		      remove_replace_entry (&idx, e);
+		    }
+		  else
 		    {
-		      /* Snip out this entry from the chain.  */
+		      if (tail == &current->archive_next)
+			tail = current_ptr;
 		      *current_ptr = (*current_ptr)->archive_next;
-		      changed = TRUE;
 		    }
-
-		  goto next_file;
+		  changed = TRUE;
 		}
-	      current_ptr = &(current->archive_next);
+
+	      goto next_file;
 	    }
 	}
 
-      /* Add to the end of the archive.  */
-      after_bfd = get_pos_bfd (&arch->archive_next, pos_end, NULL);
+      /* Add to the end of the archive.  Entries are only ever removed
+	 when they are replaced, so TAIL still leads to the end.  */
+      if (postype == pos_default)
+	after_bfd = get_pos_bfd (tail, pos_end, NULL);
+      else
+	after_bfd = get_pos_bfd (&arch->archive_next, pos_end, NULL);
 
       if (ar_emul_append (after_bfd, *files_to_move, target,
 			  verbose, make_thin_archive))
-	changed = TRUE;
+	{
+	  changed = TRUE;
+	  tail = after_bfd;
+	  if (indexed)
+	    note_replace_added (&idx, after_bfd, NULL);
+	}
 
     next_file:;
 
       files_to_move++;
     }
 
+  if (indexed)
+    free_replace_index (&idx);
+
   if (changed)
     write_archive (arch);
   else
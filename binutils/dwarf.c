@@ -846,6 +846,15 @@ abbrev_entry;
 static abbrev_entry *first_abbrev = NULL;
 static abbrev_entry *last_abbrev = NULL;
 
+/* Abbreviation numbers are normally small and allocated densely, so
+   the entries of the current list with numbers below ABBREV_INDEX_MAX
+   are also indexed by number.  This avoids scanning the list for
+   every DIE.  */
+#define ABBREV_INDEX_MAX 65536
+
+static abbrev_entry **abbrev_index = NULL;
+static unsigned long abbrev_index_size = 0;
+
 static void
 free_abbrevs (void)
 {
@@ -869,6 +878,10 @@ free_abbrevs (void)
     }
 
   last_abbrev = first_abbrev = NULL;
+
+  free (abbrev_index);
+  abbrev_index = NULL;
+  abbrev_index_size = 0;
 }
 
 static void
@@ -894,6 +907,49 @@ add_abbrev (unsigned long number, unsigned long tag, int children)
     last_abbrev->next = entry;
 
   last_abbrev = entry;
+
+  if (number < ABBREV_INDEX_MAX)
+    {
+      if (number >= abbrev_index_size)
+	{
+	  unsigned long size = abbrev_index_size ? abbrev_index_size : 64;
+	  abbrev_entry **index;
+
+	  while (number >= size)
+	    size *= 2;
+	  index = (abbrev_entry **) realloc (abbrev_index,
+					     size * sizeof (*index));
+	  if (index == NULL)
+	    /* ugg */
+	    return;
+	  memset (index + abbrev_index_size, 0,
+		  (size - abbrev_index_size) * sizeof (*index));
+	  abbrev_index = index;
+	  abbrev_index_size = size;
+	}
+
+      /* Like a scan of the list, find the first entry with a
+	 duplicated number.  */
+      if (abbrev_index[number] == NULL)
+	abbrev_index[number] = entry;
+    }
+}
+
+/* Return the entry in the current abbreviation list for NUMBER, or
+   NULL if there is none.  */
+
+static abbrev_entry *
+find_abbrev_entry (unsigned long number)
+{
+  abbrev_entry *entry;
+
+  if (number < ABBREV_INDEX_MAX)
+    return number < abbrev_index_size ? abbrev_index[number] : NULL;
+
+  for (entry = first_abbrev; entry != NULL; entry = entry->next)
+    if (entry->entry == number)
+      break;
+  return entry;
 }
 
 static void
@@ -2735,9 +2791,7 @@ read_and_display_attr_value (unsigned long           attribute,
 	       yet.  */
 	    if (form != DW_FORM_ref_addr)
 	      {
-		for (entry = first_abbrev; entry != NULL; entry = entry->next)
-		  if (entry->entry == abbrev_number)
-		    break;
+		entry = find_abbrev_entry (abbrev_number);
 		if (entry != NULL)
 		  printf (" (%s)", get_TAG_name (entry->tag));
 	      }
@@ -2868,6 +2922,8 @@ process_debug_info (struct dwarf_section *           section,
   unsigned char *section_begin;
   unsigned int unit;
   unsigned int num_units = 0;
+  unsigned char *prev_abbrev_start = NULL;
+  unsigned char *prev_abbrev_end = NULL;
 
   if ((do_loc || do_debug_loc || do_debug_ranges)
       && num_debug_info_entries == 0
@@ -2973,6 +3029,8 @@ process_debug_info (struct dwarf_section *           section,
       struct cu_tu_set *this_set;
       dwarf_vma abbrev_base;
       size_t abbrev_size;
+      unsigned char *abbrev_start;
+      unsigned char *abbrev_end;
 
       hdrptr = start;
 
@@ -3144,9 +3202,9 @@ process_debug_info (struct dwarf_section *           section,
 	  continue;
 	}
 
-      free_abbrevs ();
-
       /* Process the abbrevs used by this compilation unit.  */
+      abbrev_start = NULL;
+      abbrev_end = NULL;
       if (compunit.cu_abbrev_offset >= abbrev_size)
 	warn (_("Debug info is corrupted, abbrev offset (%lx) is larger than abbrev section size (%lx)\n"),
 	      (unsigned long) compunit.cu_abbrev_offset,
@@ -3158,11 +3216,25 @@ process_debug_info (struct dwarf_section *           section,
 	      (unsigned long) abbrev_base + abbrev_size,
 	      (unsigned long) debug_displays [abbrev_sec].section.size);
       else
-	process_abbrev_section
-	  (((unsigned char *) debug_displays [abbrev_sec].section.start
-	    + abbrev_base + compunit.cu_abbrev_offset),
-	   ((unsigned char *) debug_displays [abbrev_sec].section.start
-	    + abbrev_base + abbrev_size));
+	{
+	  abbrev_start = ((unsigned char *) debug_displays [abbrev_sec].section.start
+			  + abbrev_base + compunit.cu_abbrev_offset);
+	  abbrev_end = ((unsigned char *) debug_displays [abbrev_sec].section.start
+			+ abbrev_base + abbrev_size);
+	}
+
+      /* Units often share an abbreviation table with the one before,
+	 as type units always do, so only read it when it changes.  */
+      if (abbrev_start == NULL
+	  || abbrev_start != prev_abbrev_start
+	  || abbrev_end != prev_abbrev_end)
+	{
+	  free_abbrevs ();
+	  if (abbrev_start != NULL)
+	    process_abbrev_section (abbrev_start, abbrev_end);
+	  prev_abbrev_start = abbrev_start;
+	  prev_abbrev_end = abbrev_end;
+	}
 
       level = 0;
       last_level = level;
@@ -3242,12 +3314,7 @@ process_debug_info (struct dwarf_section *           section,
 		}
 	    }
 
-	  /* Scan through the abbreviation list until we reach the
-	     correct entry.  */
-	  for (entry = first_abbrev;
-	       entry && entry->entry != abbrev_number;
-	       entry = entry->next)
-	    continue;
+	  entry = find_abbrev_entry (abbrev_number);
 
 	  if (entry == NULL)
 	    {
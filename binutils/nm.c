@@ -40,14 +40,30 @@
 #include "plugin.h"
 
 /* When sorting by size, we use this structure to hold the size and a
-   pointer to the minisymbol.  */
+   pointer to the minisymbol, along with its name for breaking ties.  */
 
 struct size_sym
 {
   const void *minisym;
+  const char *name;
   bfd_vma size;
 };
 
+/* Before sorting, the properties of each minisymbol that the sort
+   routines compare are extracted into one of these, so that they are
+   computed once per symbol rather than once per comparison.  */
+
+struct sort_key
+{
+  const char *name;
+  bfd_vma value;
+  bfd_vma section_vma;
+  unsigned int undefined : 1;
+  unsigned int compiled : 1;
+  unsigned int file : 1;
+  long index;
+};
+
 /* When fetching relocs, we use this structure to pass information to
    get_relocs.  */
 
@@ -416,20 +432,27 @@ print_symdef_entry (bfd *abfd)
   symindex idx = BFD_NO_MORE_SYMBOLS;
   carsym *thesym;
   bfd_boolean everprinted = FALSE;
+  bfd *elt = NULL;
+  file_ptr elt_offset = -1;
 
   for (idx = bfd_get_next_mapent (abfd, idx, &thesym);
        idx != BFD_NO_MORE_SYMBOLS;
        idx = bfd_get_next_mapent (abfd, idx, &thesym))
     {
-      bfd *elt;
       if (!everprinted)
 	{
 	  printf (_("\nArchive index:\n"));
 	  everprinted = TRUE;
 	}
-      elt = bfd_get_elt_at_index (abfd, idx);
-      if (elt == NULL)
-	bfd_fatal ("bfd_get_elt_at_index");
+      /* Runs of symbols from the same member are the norm, so only
+	 look the member up when it changes.  */
+      if (elt == NULL || thesym->file_offset != elt_offset)
+	{
+	  elt = bfd_get_elt_at_index (abfd, idx);
+	  if (elt == NULL)
+	    bfd_fatal ("bfd_get_elt_at_index");
+	  elt_offset = thesym->file_offset;
+	}
       if (thesym->name != (char *) NULL)
 	{
 	  print_symname ("%s", thesym->name, abfd);
@@ -520,34 +543,19 @@ filter_symbols (bfd *abfd, bfd_boolean is_dynamic, void *minisyms,
   return (to - (bfd_byte *) minisyms) / size;
 }
 
-/* These globals are used to pass information into the sorting
-   routines.  */
-static bfd *sort_bfd;
-static bfd_boolean sort_dynamic;
+/* These globals are used by the sorting routines as space to convert
+   minisymbols into.  */
 static asymbol *sort_x;
 static asymbol *sort_y;
 
 /* Symbol-sorting predicates */
 #define valueof(x) ((x)->section->vma + (x)->value)
 
-/* Numeric sorts.  Undefined symbols are always considered "less than"
-   defined symbols with zero values.  Common symbols are not treated
-   specially -- i.e., their sizes are used as their "values".  */
+/* Compare two symbol names.  */
 
 static int
-non_numeric_forward (const void *P_x, const void *P_y)
+compare_names (const char *xn, const char *yn)
 {
-  asymbol *x, *y;
-  const char *xn, *yn;
-
-  x = bfd_minisymbol_to_symbol (sort_bfd, sort_dynamic, P_x, sort_x);
-  y = bfd_minisymbol_to_symbol (sort_bfd, sort_dynamic, P_y, sort_y);
-  if (x == NULL || y == NULL)
-    bfd_fatal (bfd_get_filename (sort_bfd));
-
-  xn = bfd_asymbol_name (x);
-  yn = bfd_asymbol_name (y);
-
   if (yn == NULL)
     return xn != NULL;
   if (xn == NULL)
@@ -567,6 +575,19 @@ non_numeric_forward (const void *P_x, const void *P_y)
 #endif
 }
 
+/* Numeric sorts.  Undefined symbols are always considered "less than"
+   defined symbols with zero values.  Common symbols are not treated
+   specially -- i.e., their sizes are used as their "values".  */
+
+static int
+non_numeric_forward (const void *P_x, const void *P_y)
+{
+  const struct sort_key *x = (const struct sort_key *) P_x;
+  const struct sort_key *y = (const struct sort_key *) P_y;
+
+  return compare_names (x->name, y->name);
+}
+
 static int
 non_numeric_reverse (const void *x, const void *y)
 {
@@ -576,26 +597,18 @@ non_numeric_reverse (const void *x, const void *y)
 static int
 numeric_forward (const void *P_x, const void *P_y)
 {
-  asymbol *x, *y;
-  asection *xs, *ys;
+  const struct sort_key *x = (const struct sort_key *) P_x;
+  const struct sort_key *y = (const struct sort_key *) P_y;
 
-  x = bfd_minisymbol_to_symbol (sort_bfd, sort_dynamic, P_x, sort_x);
-  y =  bfd_minisymbol_to_symbol (sort_bfd, sort_dynamic, P_y, sort_y);
-  if (x == NULL || y == NULL)
-    bfd_fatal (bfd_get_filename (sort_bfd));
-
-  xs = bfd_get_section (x);
-  ys = bfd_get_section (y);
-
-  if (bfd_is_und_section (xs))
+  if (x->undefined)
     {
-      if (! bfd_is_und_section (ys))
+      if (! y->undefined)
 	return -1;
     }
-  else if (bfd_is_und_section (ys))
+  else if (y->undefined)
     return 1;
-  else if (valueof (x) != valueof (y))
-    return valueof (x) < valueof (y) ? -1 : 1;
+  else if (x->value != y->value)
+    return x->value < y->value ? -1 : 1;
 
   return non_numeric_forward (P_x, P_y);
 }
@@ -626,66 +639,31 @@ static int (*(sorters[2][2])) (const void *, const void *) =
 static int
 size_forward1 (const void *P_x, const void *P_y)
 {
-  asymbol *x, *y;
-  asection *xs, *ys;
-  const char *xn, *yn;
-  size_t xnl, ynl;
-  int xf, yf;
-
-  x = bfd_minisymbol_to_symbol (sort_bfd, sort_dynamic, P_x, sort_x);
-  y = bfd_minisymbol_to_symbol (sort_bfd, sort_dynamic, P_y, sort_y);
-  if (x == NULL || y == NULL)
-    bfd_fatal (bfd_get_filename (sort_bfd));
+  const struct sort_key *x = (const struct sort_key *) P_x;
+  const struct sort_key *y = (const struct sort_key *) P_y;
 
-  xs = bfd_get_section (x);
-  ys = bfd_get_section (y);
-
-  if (bfd_is_und_section (xs))
+  if (x->undefined)
     abort ();
-  if (bfd_is_und_section (ys))
+  if (y->undefined)
     abort ();
 
-  if (valueof (x) != valueof (y))
-    return valueof (x) < valueof (y) ? -1 : 1;
-
-  if (xs->vma != ys->vma)
-    return xs->vma < ys->vma ? -1 : 1;
+  if (x->value != y->value)
+    return x->value < y->value ? -1 : 1;
 
-  xn = bfd_asymbol_name (x);
-  yn = bfd_asymbol_name (y);
-  xnl = strlen (xn);
-  ynl = strlen (yn);
+  if (x->section_vma != y->section_vma)
+    return x->section_vma < y->section_vma ? -1 : 1;
 
   /* The symbols gnu_compiled and gcc2_compiled convey even less
      information than the file name, so sort them out first.  */
 
-  xf = (strstr (xn, "gnu_compiled") != NULL
-	|| strstr (xn, "gcc2_compiled") != NULL);
-  yf = (strstr (yn, "gnu_compiled") != NULL
-	|| strstr (yn, "gcc2_compiled") != NULL);
-
-  if (xf && ! yf)
+  if (x->compiled && ! y->compiled)
     return -1;
-  if (! xf && yf)
+  if (! x->compiled && y->compiled)
     return 1;
 
-  /* We use a heuristic for the file name.  It may not work on non
-     Unix systems, but it doesn't really matter; the only difference
-     is precisely which symbol names get printed.  */
-
-#define file_symbol(s, sn, snl)			\
-  (((s)->flags & BSF_FILE) != 0			\
-   || ((snl) > 2				\
-       && (sn)[(snl) - 2] == '.'		\
-       && ((sn)[(snl) - 1] == 'o'		\
-	   || (sn)[(snl) - 1] == 'a')))
-
-  xf = file_symbol (x, xn, xnl);
-  yf = file_symbol (y, yn, ynl);
-
-  if (xf && ! yf)
+  if (x->file && ! y->file)
     return -1;
-  if (! xf && yf)
+  if (! x->file && y->file)
     return 1;
 
   return non_numeric_forward (P_x, P_y);
@@ -704,8 +682,74 @@ size_forward2 (const void *P_x, const void *P_y)
     return reverse_sort ? 1 : -1;
   else if (x->size > y->size)
     return reverse_sort ? -1 : 1;
+  else if (reverse_sort)
+    return - compare_names (x->name, y->name);
   else
-    return sorters[0][reverse_sort] (x->minisym, y->minisym);
+    return compare_names (x->name, y->name);
+}
+
+/* Sort the SYMCOUNT minisymbols of SIZE bytes each in MINISYMS using
+   COMPARE, one of the sort_key comparison routines above.  */
+
+static void
+sort_minisyms (bfd *abfd, bfd_boolean is_dynamic, void *minisyms,
+	       long symcount, unsigned int size,
+	       int (*compare) (const void *, const void *))
+{
+  struct sort_key *keys;
+  bfd_byte *sorted;
+  long i;
+
+  keys = (struct sort_key *) xmalloc (symcount * sizeof (*keys));
+  for (i = 0; i < symcount; i++)
+    {
+      asymbol *sym;
+      asection *sec;
+      const char *name;
+
+      sym = bfd_minisymbol_to_symbol (abfd, is_dynamic,
+				      (bfd_byte *) minisyms + i * size,
+				      sort_x);
+      if (sym == NULL)
+	bfd_fatal (bfd_get_filename (abfd));
+
+      sec = bfd_get_section (sym);
+      name = bfd_asymbol_name (sym);
+      keys[i].name = name;
+      keys[i].value = valueof (sym);
+      keys[i].section_vma = sec->vma;
+      keys[i].undefined = bfd_is_und_section (sec);
+      keys[i].compiled = 0;
+      keys[i].file = (sym->flags & BSF_FILE) != 0;
+      keys[i].index = i;
+
+      if (compare == size_forward1)
+	{
+	  size_t len = strlen (name);
+
+	  keys[i].compiled = (strstr (name, "gnu_compiled") != NULL
+			      || strstr (name, "gcc2_compiled") != NULL);
+
+	  /* We use a heuristic for the file name.  It may not work on
+	     non Unix systems, but it doesn't really matter; the only
+	     difference is precisely which symbol names get printed.  */
+	  if (len > 2
+	      && name[len - 2] == '.'
+	      && (name[len - 1] == 'o' || name[len - 1] == 'a'))
+	    keys[i].file = 1;
+	}
+    }
+
+  qsort (keys, symcount, sizeof (*keys), compare);
+
+  sorted = (bfd_byte *) xmalloc (symcount * size);
+  for (i = 0; i < symcount; i++)
+    memcpy (sorted + i * size, (bfd_byte *) minisyms + keys[i].index * size,
+	    size);
+  memcpy (minisyms, sorted, symcount * size);
+
+  free (sorted);
+  free (keys);
 }
 
 /* Sort the symbols by size.  ELF provides a size but for other formats
@@ -723,7 +767,7 @@ sort_symbols_by_size (bfd *abfd, bfd_boolean is_dynamic, void *minisyms,
   asymbol *sym = NULL;
   asymbol *store_sym, *store_next;
 
-  qsort (minisyms, symcount, size, size_forward1);
+  sort_minisyms (abfd, is_dynamic, minisyms, symcount, size, size_forward1);
 
   /* We are going to return a special set of symbols and sizes to
      print.  */
@@ -791,6 +835,7 @@ sort_symbols_by_size (bfd *abfd, bfd_boolean is_dynamic, void *minisyms,
       if (sz != 0)
 	{
 	  symsizes->minisym = (const void *) from;
+	  symsizes->name = bfd_asymbol_name (sym);
 	  symsizes->size = sz;
 	  ++symsizes;
 	}
@@ -1173,16 +1218,14 @@ display_rel_file (bfd *abfd, bfd *archive_bfd)
   symsizes = NULL;
   if (! no_sort)
     {
-      sort_bfd = abfd;
-      sort_dynamic = dynamic;
       sort_x = bfd_make_empty_symbol (abfd);
       sort_y = bfd_make_empty_symbol (abfd);
       if (sort_x == NULL || sort_y == NULL)
 	bfd_fatal (bfd_get_filename (abfd));
 
       if (! sort_by_size)
-	qsort (minisyms, symcount, size,
-	       sorters[sort_numerically][reverse_sort]);
+	sort_minisyms (abfd, dynamic, minisyms, symcount, size,
+		       sorters[sort_numerically][reverse_sort]);
       else
 	symcount = sort_symbols_by_size (abfd, dynamic, minisyms, symcount,
 					 size, &symsizes);
@@ -4134,6 +4134,34 @@ copy_section (bfd *ibfd, sec_ptr isection, void *obfdarg)
     {
       bfd_byte *memhunk = NULL;
 
+      /* If the contents are copied unchanged, write them straight from
+	 a read-only view of the input.  Where possible the view maps
+	 the input file, so large sections are neither read into nor
+	 held in a buffer of their own.  Output of the same target
+	 never needs bfd_convert_section_contents.  */
+      if (reverse_bytes == 0
+	  && copy_byte < 0
+	  && ibfd->xvec == obfd->xvec)
+	{
+	  bfd_window window;
+
+	  bfd_init_window (&window);
+	  if (!bfd_get_full_section_contents_in_window (ibfd, isection,
+							&window))
+	    {
+	      status = 1;
+	      bfd_nonfatal_message (NULL, ibfd, isection, NULL);
+	    }
+	  else if (!bfd_set_section_contents (obfd, osection, window.data,
+					      0, size))
+	    {
+	      status = 1;
+	      bfd_nonfatal_message (NULL, obfd, osection, NULL);
+	    }
+	  bfd_free_window (&window);
+	  return;
+	}
+
       if (!bfd_get_full_section_contents (ibfd, isection, &memhunk)
 	  || !bfd_convert_section_contents (ibfd, isection, obfd,
 					    &memhunk, &size))
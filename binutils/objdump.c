@@ -172,6 +172,23 @@ static asymbol **sorted_syms;
 /* Number of symbols in `sorted_syms'.  */
 static long sorted_symcount = 0;
 
+/* Indices into `sorted_syms', grouped by the name of each symbol's
+   section and in ascending order within a group.  Relocatable files
+   built with -ffunction-sections have thousands of symbols sharing the
+   same value, and this lets us step through the symbols of one section
+   without walking over all the others.  */
+static long *section_syms;
+
+/* For each entry in `sorted_syms', the index of the first symbol in the
+   run of symbols with the same value that precedes it without an
+   intervening section or debugging symbol.  */
+static long *sym_run_start;
+
+/* The group in `section_syms' for the most recently used section.  */
+static asection *section_syms_sec;
+static long *section_syms_start;
+static long *section_syms_end;
+
 /* The dynamic symbol table.  */
 static asymbol **dynsyms;
 
@@ -1011,6 +1028,137 @@ sym_ok (bfd_boolean               want_section,
   return inf->symbol_is_valid (sorted_syms[place], inf);
 }
 
+/* Sort the indices in `section_syms' by section name and then by
+   position in `sorted_syms'.  */
+
+static int
+compare_section_syms (const void *ap, const void *bp)
+{
+  long a = * (const long *) ap;
+  long b = * (const long *) bp;
+  int cmp;
+
+  cmp = strcmp (sorted_syms[a]->section->name, sorted_syms[b]->section->name);
+  if (cmp != 0)
+    return cmp;
+  if (a < b)
+    return -1;
+  return a > b;
+}
+
+/* Set `section_syms_start' and `section_syms_end' to the group of
+   symbols belonging to sections named like SEC.  */
+
+static void
+find_section_syms (asection *sec)
+{
+  long lo, hi;
+
+  if (sec == section_syms_sec)
+    return;
+  section_syms_sec = sec;
+
+  lo = 0;
+  hi = sorted_symcount;
+  while (lo < hi)
+    {
+      long mid = (lo + hi) / 2;
+
+      if (strcmp (sorted_syms[section_syms[mid]]->section->name,
+		  sec->name) < 0)
+	lo = mid + 1;
+      else
+	hi = mid;
+    }
+  section_syms_start = section_syms + lo;
+
+  hi = sorted_symcount;
+  while (lo < hi)
+    {
+      long mid = (lo + hi) / 2;
+
+      if (strcmp (sorted_syms[section_syms[mid]]->section->name,
+		  sec->name) <= 0)
+	lo = mid + 1;
+      else
+	hi = mid;
+    }
+  section_syms_end = section_syms + lo;
+}
+
+/* Return the first entry of the group for SEC in `section_syms' whose
+   index in `sorted_syms' is greater than PLACE.  */
+
+static long *
+section_syms_after (asection *sec, long place)
+{
+  long *lo, *hi;
+
+  find_section_syms (sec);
+  lo = section_syms_start;
+  hi = section_syms_end;
+  while (lo < hi)
+    {
+      long *mid = lo + (hi - lo) / 2;
+
+      if (*mid <= place)
+	lo = mid + 1;
+      else
+	hi = mid;
+    }
+  return lo;
+}
+
+/* Return the index of the next symbol after PLACE that sym_ok might
+   accept, or sorted_symcount if there are none.  When WANT_SECTION,
+   symbols not in SEC are skipped.  */
+
+static long
+next_sym_place (bfd_boolean want_section, asection *sec, long place)
+{
+  long *p;
+
+  if (!want_section)
+    return place + 1;
+
+  p = section_syms_after (sec, place);
+  return p < section_syms_end ? *p : sorted_symcount;
+}
+
+/* Likewise for the symbol before PLACE, returning -1 if there are
+   none.  */
+
+static long
+prev_sym_place (bfd_boolean want_section, asection *sec, long place)
+{
+  long *p;
+
+  if (!want_section)
+    return place - 1;
+
+  p = section_syms_after (sec, place - 1);
+  return p > section_syms_start ? p[-1] : -1;
+}
+
+/* Return the index of the first symbol in `sorted_syms' in the range
+   [LO, HI) whose value is greater than VMA, or HI if there is
+   none.  */
+
+static long
+sym_value_upper_bound (bfd_vma vma, long lo, long hi)
+{
+  while (lo < hi)
+    {
+      long mid = (lo + hi) / 2;
+
+      if (bfd_asymbol_value (sorted_syms[mid]) <= vma)
+	lo = mid + 1;
+      else
+	hi = mid;
+    }
+  return lo;
+}
+
 /* Locate a symbol given a bfd and a section (from INFO->application_data),
    and a VMA.  If INFO->application_data->require_sec is TRUE, then always
    require the symbol to be in the section.  Returns NULL if there is no
@@ -1069,22 +1217,16 @@ find_symbol_for_address (bfd_vma vma,
   /* The symbol we want is now in min, the low end of the range we
      were searching.  If there are several symbols with the same
      value, we want the first (non-section/non-debugging) one.  */
-  thisplace = min;
-  while (thisplace > 0
-	 && (bfd_asymbol_value (sorted_syms[thisplace])
-	     == bfd_asymbol_value (sorted_syms[thisplace - 1]))
-	 && ((sorted_syms[thisplace - 1]->flags
-	      & (BSF_SECTION_SYM | BSF_DEBUGGING)) == 0)
-	 )
-    --thisplace;
+  thisplace = sym_run_start[min];
 
   /* Prefer a symbol in the current section if we have multple symbols
      with the same value, as can occur with overlays or zero size
      sections.  */
-  min = thisplace;
-  while (min < max_count
-	 && (bfd_asymbol_value (sorted_syms[min])
-	     == bfd_asymbol_value (sorted_syms[thisplace])))
+  max_count = sym_value_upper_bound (bfd_asymbol_value (sorted_syms[thisplace]),
+				     thisplace, max_count);
+  for (min = next_sym_place (TRUE, sec, thisplace - 1);
+       min < max_count;
+       min = next_sym_place (TRUE, sec, min))
     {
       if (sym_ok (TRUE, abfd, min, sec, inf))
 	{
@@ -1095,8 +1237,8 @@ find_symbol_for_address (bfd_vma vma,
 
 	  return sorted_syms[thisplace];
 	}
-      ++min;
     }
+  min = max_count;
 
   /* If the file is relocatable, and the symbol could be from this
      section, prefer a symbol from this section over symbols from
@@ -1119,7 +1261,9 @@ find_symbol_for_address (bfd_vma vma,
       long i;
       long newplace = sorted_symcount;
 
-      for (i = min - 1; i >= 0; i--)
+      for (i = prev_sym_place (want_section, sec, min);
+	   i >= 0;
+	   i = prev_sym_place (want_section, sec, i))
 	{
 	  if (sym_ok (want_section, abfd, i, sec, inf))
 	    {
@@ -1142,7 +1286,9 @@ find_symbol_for_address (bfd_vma vma,
 	{
 	  /* We didn't find a good symbol with a smaller value.
 	     Look for one with a larger value.  */
-	  for (i = thisplace + 1; i < sorted_symcount; i++)
+	  for (i = next_sym_place (want_section, sec, thisplace);
+	       i < sorted_symcount;
+	       i = next_sym_place (want_section, sec, i))
 	    {
 	      if (sym_ok (want_section, abfd, i, sec, inf))
 		{
@@ -1359,13 +1505,15 @@ static char *prev_functionname;
 static unsigned int prev_line;
 static unsigned int prev_discriminator;
 
-/* We keep a list of all files that we have seen when doing a
+/* We keep a table of all files that we have seen when doing a
    disassembly with source, so that we know how much of the file to
-   display.  This can be important for inlined functions.  */
+   display.  This can be important for inlined functions.  The table is
+   consulted for every instruction, so it is hashed by filename, and
+   files that could not be opened are remembered with a NULL map so
+   that we do not try to open them again.  */
 
 struct print_file_list
 {
-  struct print_file_list *next;
   const char *filename;
   const char *modname;
   const char *map;
@@ -1377,7 +1525,7 @@ struct print_file_list
   int first;
 };
 
-static struct print_file_list *print_files;
+static htab_t print_files;
 
 /* The number of preceding context lines to show when we start
    displaying a file for the first time.  */
@@ -1479,8 +1627,24 @@ index_file (const char *map, size_t size, unsigned int *maxline)
   return linemap;
 }
 
-/* Tries to open MODNAME, and if successful adds a node to print_files
-   linked list and returns that node.  Returns NULL on failure.  */
+/* Hash and compare functions for print_files.  Lookups are done with
+   the filename as the key.  */
+
+static hashval_t
+hash_print_file (const void *p)
+{
+  return filename_hash (((const struct print_file_list *) p)->filename);
+}
+
+static int
+eq_print_file (const void *p, const void *filename)
+{
+  return filename_eq (((const struct print_file_list *) p)->filename,
+		      filename);
+}
+
+/* Tries to open MODNAME, and if successful returns a new node for
+   print_files.  Returns NULL on failure.  */
 
 static struct print_file_list *
 try_print_file_open (const char *origname, const char *modname, struct stat *fst)
@@ -1501,15 +1665,13 @@ try_print_file_open (const char *origname, const char *modname, struct stat *fst
   p->max_printed = 0;
   p->filename = origname;
   p->modname = modname;
-  p->next = print_files;
   p->first = 1;
-  print_files = p;
   return p;
 }
 
 /* If the source file, as described in the symtab, is not found
    try to locate it in one of the paths specified with -I
-   If found, add location to print_files linked list.  */
+   If found, return a print_files node for that location.  */
 
 static struct print_file_list *
 update_source_path (const char *filename, bfd *abfd)
@@ -1694,22 +1856,28 @@ show_line (bfd *abfd, asection *section, bfd_vma addr_offset)
       && filename != NULL
       && linenumber > 0)
     {
-      struct print_file_list **pp, *p;
+      struct print_file_list *p;
+      void **slot;
       unsigned l;
 
-      for (pp = &print_files; *pp != NULL; pp = &(*pp)->next)
-	if (filename_cmp ((*pp)->filename, filename) == 0)
-	  break;
-      p = *pp;
+      slot = htab_find_slot_with_hash (print_files, filename,
+				       filename_hash (filename), INSERT);
+      p = (struct print_file_list *) *slot;
 
       if (p == NULL)
 	{
 	  if (reloc)
 	    filename = xstrdup (filename);
 	  p = update_source_path (filename, abfd);
+	  if (p == NULL)
+	    {
+	      p = (struct print_file_list *) xcalloc (1, sizeof (*p));
+	      p->filename = filename;
+	    }
+	  *slot = p;
 	}
 
-      if (p != NULL && linenumber != p->last_line)
+      if (p->map != NULL && linenumber != p->last_line)
 	{
 	  if (file_start_context && p->first)
 	    l = 1;
@@ -2222,6 +2390,7 @@ disassemble_section (bfd *abfd, asection *section, void *inf)
   struct disassemble_info *    pinfo = (struct disassemble_info *) inf;
   struct objdump_disasm_info * paux;
   unsigned int                 opb = pinfo->octets_per_byte;
+  bfd_window                   window;
   bfd_byte *                   data = NULL;
   bfd_size_type                datasize = 0;
   arelent **                   rel_pp = NULL;
@@ -2317,12 +2486,14 @@ disassemble_section (bfd *abfd, asection *section, void *inf)
     }
   rel_ppend = rel_pp + rel_count;
 
-  if (!bfd_malloc_and_get_section (abfd, section, &data))
+  bfd_init_window (&window);
+  if (!bfd_get_full_section_contents_in_window (abfd, section, &window))
     {
       non_fatal (_("Reading section %s failed because: %s"),
 		 section->name, bfd_errmsg (bfd_get_error ()));
       return;
     }
+  data = (bfd_byte *) window.data;
 
   paux->sec = section;
   pinfo->buffer = data;
@@ -2372,13 +2543,9 @@ disassemble_section (bfd *abfd, asection *section, void *inf)
 
       if (sym != NULL && bfd_asymbol_value (sym) <= addr)
 	{
-	  int x;
+	  long x;
 
-	  for (x = place;
-	       (x < sorted_symcount
-		&& (bfd_asymbol_value (sorted_syms[x]) <= addr));
-	       ++x)
-	    continue;
+	  x = sym_value_upper_bound (addr, place, sorted_symcount);
 
 	  pinfo->symbols = sorted_syms + place;
 	  pinfo->num_symbols = x - place;
@@ -2490,9 +2657,10 @@ disassemble_section (bfd *abfd, asection *section, void *inf)
 	     SECTION.  Note that all the symbols are sorted
 	     together into one big array, and that some sections
 	     may have overlapping addresses.  */
+	  place = next_sym_place (TRUE, section, place - 1);
 	  while (place < sorted_symcount
 		 && ! is_valid_next_sym (sorted_syms [place]))
-	    ++place;
+	    place = next_sym_place (TRUE, section, place);
 
 	  if (place >= sorted_symcount)
 	    nextsym = NULL;
@@ -2537,7 +2705,7 @@ disassemble_section (bfd *abfd, asection *section, void *inf)
       sym = nextsym;
     }
 
-  free (data);
+  bfd_free_window (&window);
 
   if (rel_ppstart != NULL)
     free (rel_ppstart);
@@ -2552,7 +2720,8 @@ disassemble_data (bfd *abfd)
   struct objdump_disasm_info aux;
   long i;
 
-  print_files = NULL;
+  print_files = htab_create_alloc (16, hash_print_file, eq_print_file,
+				   NULL, xcalloc, free);
   prev_functionname = NULL;
   prev_line = -1;
   prev_discriminator = 0;
@@ -2576,6 +2745,25 @@ disassemble_data (bfd *abfd)
   /* Sort the symbols into section and symbol order.  */
   qsort (sorted_syms, sorted_symcount, sizeof (asymbol *), compare_symbols);
 
+  section_syms = (long *) xmalloc (sorted_symcount * sizeof (long));
+  for (i = 0; i < sorted_symcount; ++i)
+    section_syms[i] = i;
+  qsort (section_syms, sorted_symcount, sizeof (long), compare_section_syms);
+  section_syms_sec = NULL;
+
+  sym_run_start = (long *) xmalloc (sorted_symcount * sizeof (long));
+  for (i = 0; i < sorted_symcount; ++i)
+    {
+      if (i > 0
+	  && (bfd_asymbol_value (sorted_syms[i])
+	      == bfd_asymbol_value (sorted_syms[i - 1]))
+	  && ((sorted_syms[i - 1]->flags
+	       & (BSF_SECTION_SYM | BSF_DEBUGGING)) == 0))
+	sym_run_start[i] = sym_run_start[i - 1];
+      else
+	sym_run_start[i] = i;
+    }
+
   init_disassemble_info (&disasm_info, stdout, (fprintf_ftype) fprintf);
 
   disasm_info.application_data = (void *) &aux;
@@ -2670,6 +2858,9 @@ disassemble_data (bfd *abfd)
 
   if (aux.dynrelbuf != NULL)
     free (aux.dynrelbuf);
+  free (sym_run_start);
+  htab_delete (print_files);
+  free (section_syms);
   free (sorted_syms);
 }
 
@@ -3252,7 +3443,8 @@ dump_target_specific (bfd *abfd)
 static void
 dump_section (bfd *abfd, asection *section, void *dummy ATTRIBUTE_UNUSED)
 {
-  bfd_byte *data = NULL;
+  bfd_window window;
+  bfd_byte *data;
   bfd_size_type datasize;
   bfd_vma addr_offset;
   bfd_vma start_offset;
@@ -3302,12 +3494,14 @@ dump_section (bfd *abfd, asection *section, void *dummy ATTRIBUTE_UNUSED)
 	    (unsigned long) (section->filepos + start_offset));
   printf ("\n");
 
-  if (!bfd_get_full_section_contents (abfd, section, &data))
+  bfd_init_window (&window);
+  if (!bfd_get_full_section_contents_in_window (abfd, section, &window))
     {
       non_fatal (_("Reading section %s failed because: %s"),
 		 section->name, bfd_errmsg (bfd_get_error ()));
       return;
     }
+  data = (bfd_byte *) window.data;
 
   width = 4;
 
@@ -3374,7 +3568,7 @@ dump_section (bfd *abfd, asection *section, void *dummy ATTRIBUTE_UNUSED)
 	}
       putchar ('\n');
     }
-  free (data);
+  bfd_free_window (&window);
 }
 
 /* Actually display the various requested regions.  */
@@ -228,7 +228,7 @@ static Elf_Internal_Syminfo * dynamic_syminfo;
 static unsigned long dynamic_syminfo_offset;
 static unsigned int dynamic_syminfo_nent;
 static char program_interpreter[PATH_MAX];
-static bfd_vma dynamic_info[DT_ENCODING];
+static bfd_vma dynamic_info[DT_RELRENT + 1];
 static bfd_vma dynamic_info_DT_GNU_HASH;
 static bfd_vma version_info[16];
 static Elf_Internal_Dyn *  dynamic_section;
@@ -1803,6 +1803,91 @@ dump_relocations (Filedata *          filedata,
   return res;
 }
 
+/* Display the contents of the packed relative relocation data found at
+   the specified offset.  Each word of an SHT_RELR table is either an
+   even address, which is relocated and becomes the new base, or an odd
+   bitmap whose bits 1..N-1 select which of the following N-1 words
+   after the base are also relocated.  */
+
+static bfd_boolean
+dump_relr_relocations (Filedata *     filedata,
+		       unsigned long  relr_offset,
+		       unsigned long  relr_size)
+{
+  unsigned int entsize = is_32bit_elf ? 4 : 8;
+  unsigned int nbits = entsize * 8 - 1;
+  unsigned char * data;
+  unsigned long nentries;
+  unsigned long nrelocs;
+  unsigned long i;
+  bfd_vma base;
+
+  if (relr_size % entsize != 0)
+    {
+      warn (_("RELR relocation size 0x%lx is not a multiple of %u\n"),
+	    relr_size, entsize);
+      return FALSE;
+    }
+
+  data = (unsigned char *) get_data (NULL, filedata, relr_offset, 1,
+				     relr_size, _("RELR relocation data"));
+  if (data == NULL)
+    return FALSE;
+
+  nentries = relr_size / entsize;
+
+  /* Count the relocated locations first so that the header can
+     report them.  */
+  for (i = 0, nrelocs = 0; i < nentries; i++)
+    {
+      bfd_vma entry = byte_get (data + i * entsize, entsize);
+      unsigned int j;
+
+      if ((entry & 1) == 0)
+	nrelocs++;
+      else
+	for (j = 1; j <= nbits; j++)
+	  if ((entry >> j) & 1)
+	    nrelocs++;
+    }
+
+  printf (ngettext ("%lu offset\n", "%lu offsets\n", nrelocs), nrelocs);
+  printf (is_32bit_elf ? _(" Offset\n") : _("  Offset\n"));
+
+  base = 0;
+  for (i = 0; i < nentries; i++)
+    {
+      bfd_vma entry = byte_get (data + i * entsize, entsize);
+
+      if ((entry & 1) == 0)
+	{
+	  print_vma (entry, LONG_HEX);
+	  putchar ('\n');
+	  base = entry + entsize;
+	}
+      else if (i == 0)
+	{
+	  warn (_("RELR relocation data starts with a bitmap entry\n"));
+	  break;
+	}
+      else
+	{
+	  unsigned int j;
+
+	  for (j = 1; j <= nbits; j++)
+	    if ((entry >> j) & 1)
+	      {
+		print_vma (base + (j - 1) * entsize, LONG_HEX);
+		putchar ('\n');
+	      }
+	  base += (bfd_vma) nbits * entsize;
+	}
+    }
+
+  free (data);
+  return TRUE;
+}
+
 static const char *
 get_aarch64_dynamic_type (unsigned long type)
 {
@@ -2141,6 +2226,9 @@ get_dynamic_type (Filedata * filedata, unsigned long type)
     case DT_PREINIT_ARRAY: return "PREINIT_ARRAY";
     case DT_PREINIT_ARRAYSZ: return "PREINIT_ARRAYSZ";
     case DT_SYMTAB_SHNDX: return "SYMTAB_SHNDX";
+    case DT_RELRSZ:	return "RELRSZ";
+    case DT_RELR:	return "RELR";
+    case DT_RELRENT:	return "RELRENT";
 
     case DT_CHECKSUM:	return "CHECKSUM";
     case DT_PLTPADSZ:	return "PLTPADSZ";
@@ -4263,6 +4351,7 @@ get_section_type_name (Filedata * filedata, unsigned int sh_type)
     case SHT_GNU_HASH:		return "GNU_HASH";
     case SHT_GROUP:		return "GROUP";
     case SHT_SYMTAB_SHNDX:	return "SYMTAB SECTION INDICES";
+    case SHT_RELR:		return "RELR";
     case SHT_GNU_verdef:	return "VERDEF";
     case SHT_GNU_verneed:	return "VERNEED";
     case SHT_GNU_versym:	return "VERSYM";
@@ -7174,6 +7263,7 @@ static struct
 {
   { "REL", DT_REL, DT_RELSZ, FALSE },
   { "RELA", DT_RELA, DT_RELASZ, TRUE },
+  { "RELR", DT_RELR, DT_RELRSZ, UNKNOWN },
   { "PLT", DT_JMPREL, DT_PLTRELSZ, UNKNOWN }
 };
 
@@ -7227,6 +7317,15 @@ process_relocs (Filedata * filedata)
 		(_("\n'%s' relocation section at offset 0x%lx contains %ld bytes:\n"),
 		 name, rel_offset, rel_size);
 
+	      if (dynamic_relocations [i].reloc == DT_RELR)
+		{
+		  dump_relr_relocations (filedata,
+					 offset_from_vma (filedata, rel_offset,
+							  rel_size),
+					 rel_size);
+		  continue;
+		}
+
 	      dump_relocations (filedata,
 				offset_from_vma (filedata, rel_offset, rel_size),
 				rel_size,
@@ -7254,12 +7353,30 @@ process_relocs (Filedata * filedata)
 	   i++, section++)
 	{
 	  if (   section->sh_type != SHT_RELA
-	      && section->sh_type != SHT_REL)
+	      && section->sh_type != SHT_REL
+	      && section->sh_type != SHT_RELR)
 	    continue;
 
 	  rel_offset = section->sh_offset;
 	  rel_size   = section->sh_size;
 
+	  if (section->sh_type == SHT_RELR)
+	    {
+	      if (rel_size == 0)
+		continue;
+
+	      printf (_("\nRelocation section "));
+	      if (filedata->string_table == NULL)
+		printf ("%d", section->sh_name);
+	      else
+		printf ("'%s'", printable_section_name (filedata, section));
+	      printf (_(" at offset 0x%lx contains "), rel_offset);
+
+	      dump_relr_relocations (filedata, rel_offset, rel_size);
+	      found = TRUE;
+	      continue;
+	    }
+
 	  if (rel_size)
 	    {
 	      Elf_Internal_Shdr * strsec;
@@ -10247,6 +10364,7 @@ process_dynamic_section (Filedata * filedata)
 	case DT_TEXTREL	:
 	case DT_JMPREL	:
 	case DT_RUNPATH	:
+	case DT_RELR	:
 	  dynamic_info[entry->d_tag] = entry->d_un.d_val;
 
 	  if (do_dynamic)
@@ -10300,6 +10418,8 @@ process_dynamic_section (Filedata * filedata)
 	case DT_RELAENT	:
 	case DT_SYMENT	:
 	case DT_RELENT	:
+	case DT_RELRSZ	:
+	case DT_RELRENT	:
 	  dynamic_info[entry->d_tag] = entry->d_un.d_val;
 	  /* Fall through.  */
 	case DT_PLTPADSZ:
@@ -0,0 +1,3 @@
+# A data section larger than a page.
+	.data
+	.fill	8192, 1, 1
@@ -0,0 +1,30 @@
+/* Assembler source used to create an object file for testing readelf's
+   ability to decode a packed relative relocation (SHT_RELR) section.
+
+   Copyright (C) 2019 Free Software Foundation, Inc.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+
+	/* SHT_RELR is section type 19.  */
+	.section	.relr.dyn,"a",%19
+
+	/* An address, then a bitmap covering the next two words.  */
+	.quad	0x10000
+	.quad	0x7
+	/* A bitmap whose top bit stands for the 63rd word after the
+	   previous bitmap.  */
+	.quad	0x8000000000000001
+	/* A new address, then an empty bitmap which adds nothing.  */
+	.quad	0x20000
+	.quad	0x1
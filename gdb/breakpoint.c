@@ -13770,11 +13770,101 @@ breakpoint_re_set_one (breakpoint *b)
   b->ops->re_set (b);
 }
 
-/* Re-set breakpoint locations for the current program space.
-   Locations bound to other program spaces are left untouched.  */
+/* Per-program-space data used to re-set breakpoints only against the
+   objfiles that were added since the last re-set.  */
 
-void
-breakpoint_re_set (void)
+struct breakpoint_pspace_data
+{
+  /* The objfiles added to the program space since its breakpoints
+     were last re-set, including objfiles added with
+     SYMFILE_DEFER_BP_RESET.  */
+  std::vector<objfile *> new_objfiles;
+
+  /* True if symbols were discarded since the last re-set, so that
+     NEW_OBJFILES doesn't describe all that changed.  */
+  bool need_full_re_set = false;
+};
+
+/* Program space key for the data above.  */
+
+static const program_space_key<breakpoint_pspace_data> breakpoint_pspace_key;
+
+/* Return the breakpoint data of PSPACE, creating it if needed.  */
+
+static struct breakpoint_pspace_data *
+get_breakpoint_pspace_data (struct program_space *pspace)
+{
+  struct breakpoint_pspace_data *data = breakpoint_pspace_key.get (pspace);
+
+  if (data == NULL)
+    data = breakpoint_pspace_key.emplace (pspace);
+  return data;
+}
+
+/* Return true if re-setting B after the objfiles in OBJFILES were
+   added to the current program space can not change B's locations,
+   i.e., B is a plain code breakpoint whose location does not match
+   anything in OBJFILES.  Breakpoints that might be affected in other
+   ways, e.g. through their condition, are never reported as
+   unaffected.  */
+
+static bool
+breakpoint_unaffected_by_objfiles_p (breakpoint *b,
+				     const std::vector<objfile *> &objfiles)
+{
+  /* The re_set methods of other breakpoint kinds do more than
+     re-decoding the location; e.g., internal breakpoints are deleted
+     and recreated, and dprintfs re-parse their format.  */
+  if (b->ops != &bkpt_breakpoint_ops
+      || b->location_range_end != NULL)
+    return false;
+
+  /* Only linespecs and explicit locations name symbols or source
+     files that the new objfiles may provide.  */
+  enum event_location_type type = event_location_type (b->location.get ());
+  if (type != LINESPEC_LOCATION && type != EXPLICIT_LOCATION)
+    return false;
+
+  /* The condition may refer to symbols the new objfiles define.  */
+  if (b->cond_string != NULL)
+    return false;
+
+  /* A full re-set drops the locations left over from unloaded
+     libraries.  */
+  for (bp_location *loc = b->loc; loc != NULL; loc = loc->next)
+    if (loc->shlib_disabled)
+      return false;
+
+  input_radix = b->input_radix;
+  set_language (b->language);
+
+  try
+    {
+      struct linespec_result canonical;
+
+      decode_line_full (b->location.get (), DECODE_LINE_FUNFIRSTLINE,
+			current_program_space, NULL, 0,
+			&canonical, multiple_symbols_all,
+			b->filter, &objfiles);
+
+      return (canonical.lsals.empty ()
+	      || canonical.lsals[0].sals.empty ());
+    }
+  catch (const gdb_exception_error &e)
+    {
+      /* Any other error is reported by the full re-set.  */
+      return e.error == NOT_FOUND_ERROR;
+    }
+}
+
+/* Re-set breakpoint locations for the current program space.  If
+   NEW_OBJFILES is not NULL, they are the only objfiles added since
+   the last re-set, and breakpoints that are known not to be affected
+   by them are skipped.  Locations bound to other program spaces are
+   left untouched.  */
+
+static void
+breakpoint_re_set_1 (const std::vector<objfile *> *new_objfiles)
 {
   struct breakpoint *b, *b_tmp;
 
@@ -13805,7 +13895,9 @@ breakpoint_re_set (void)
       {
 	try
 	  {
-	    breakpoint_re_set_one (b);
+	    if (new_objfiles == NULL
+		|| !breakpoint_unaffected_by_objfiles_p (b, *new_objfiles))
+	      breakpoint_re_set_one (b);
 	  }
 	catch (const gdb_exception &ex)
 	  {
@@ -13826,6 +13918,66 @@ breakpoint_re_set (void)
   /* Now we can insert.  */
   update_global_location_list (UGLL_MAY_INSERT);
 }
+
+/* See breakpoint.h.  */
+
+void
+breakpoint_re_set (void)
+{
+  struct breakpoint_pspace_data *data
+    = get_breakpoint_pspace_data (current_program_space);
+
+  data->new_objfiles.clear ();
+  data->need_full_re_set = false;
+
+  breakpoint_re_set_1 (NULL);
+}
+
+/* See breakpoint.h.  */
+
+void
+breakpoint_re_set_new_objfiles (void)
+{
+  struct breakpoint_pspace_data *data
+    = get_breakpoint_pspace_data (current_program_space);
+
+  if (data->need_full_re_set)
+    {
+      breakpoint_re_set ();
+      return;
+    }
+
+  std::vector<objfile *> new_objfiles = std::move (data->new_objfiles);
+  data->new_objfiles.clear ();
+
+  breakpoint_re_set_1 (&new_objfiles);
+}
+
+/* new_objfile observer.  Record OBJFILE as added to its program
+   space since its breakpoints were last re-set.  A NULL OBJFILE means
+   that the symbols of the current program space were discarded; the
+   next re-set then can't tell what changed.  */
+
+static void
+breakpoint_new_objfile (struct objfile *objfile)
+{
+  if (objfile == NULL)
+    {
+      struct breakpoint_pspace_data *data
+	= get_breakpoint_pspace_data (current_program_space);
+
+      data->new_objfiles.clear ();
+      data->need_full_re_set = true;
+      return;
+    }
+
+  struct breakpoint_pspace_data *data
+    = get_breakpoint_pspace_data (objfile->pspace);
+
+  if (std::find (data->new_objfiles.begin (), data->new_objfiles.end (),
+		 objfile) == data->new_objfiles.end ())
+    data->new_objfiles.push_back (objfile);
+}
 
 /* Reset the thread number of this breakpoint:
 
@@ -15245,6 +15397,16 @@ breakpoint_free_objfile (struct objfile *objfile)
   ALL_BP_LOCATIONS (loc, locp)
     if (loc->symtab != NULL && SYMTAB_OBJFILE (loc->symtab) == objfile)
       loc->symtab = NULL;
+
+  struct breakpoint_pspace_data *data
+    = breakpoint_pspace_key.get (objfile->pspace);
+  if (data != NULL)
+    {
+      auto iter = std::find (data->new_objfiles.begin (),
+			     data->new_objfiles.end (), objfile);
+      if (iter != data->new_objfiles.end ())
+	data->new_objfiles.erase (iter);
+    }
 }
 
 void
@@ -15440,6 +15602,7 @@ _initialize_breakpoint (void)
 
   gdb::observers::solib_unloaded.attach (disable_breakpoints_in_unloaded_shlib);
   gdb::observers::free_objfile.attach (disable_breakpoints_in_freed_objfile);
+  gdb::observers::new_objfile.attach (breakpoint_new_objfile);
   gdb::observers::memory_changed.attach (invalidate_bp_value_on_memory_change);
 
   breakpoint_chain = 0;
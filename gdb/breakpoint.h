@@ -1234,8 +1234,18 @@ extern void update_breakpoint_locations
    gdb::array_view<const symtab_and_line> sals,
    gdb::array_view<const symtab_and_line> sals_end);
 
+/* Re-set breakpoint locations for the current program space.
+   Locations bound to other program spaces are left untouched.  */
+
 extern void breakpoint_re_set (void);
 
+/* Like breakpoint_re_set, but breakpoints whose locations can not be
+   affected by the objfiles added to the current program space since
+   its breakpoints were last re-set are left alone.  This is much
+   cheaper when many shared libraries are loaded one after another.  */
+
+extern void breakpoint_re_set_new_objfiles (void);
+
 extern void breakpoint_re_set_thread (struct breakpoint *);
 
 extern void delete_breakpoint (struct breakpoint *);
@@ -27,10 +27,15 @@
 #include "common/pathstuff.h"
 #include "dwarf-index-write.h"
 #include "dwarf2read.h"
+#include "event-loop.h"
 #include "objfiles.h"
+#include "observable.h"
 #include "common/selftest.h"
+#include "common/filestuff.h"
+#include <algorithm>
 #include <string>
 #include <stdlib.h>
+#include <utime.h>
 
 /* When set to 1, show debug messages about the index cache.  */
 static int debug_index_cache = 0;
@@ -38,6 +43,10 @@ static int debug_index_cache = 0;
 /* The index cache directory, used for "set/show index-cache directory".  */
 static char *index_cache_directory = NULL;
 
+/* The maximum size of the index cache in megabytes, or -1 for no limit.
+   Used for "set/show index-cache max-size".  */
+static int index_cache_max_size = -1;
+
 /* See dwarf-index.cache.h.  */
 index_cache global_index_cache;
 
@@ -83,10 +92,82 @@ index_cache::disable ()
   m_enabled = false;
 }
 
+/* Event loop timer callback writing the pending indices.  */
+
+static void
+index_cache_store_timer (gdb_client_data client_data)
+{
+  index_cache *cache = (index_cache *) client_data;
+
+  cache->flush_pending_stores ();
+}
+
 /* See dwarf-index-cache.h.  */
 
 void
 index_cache::store (struct dwarf2_per_objfile *dwarf2_per_objfile)
+{
+  if (!enabled ())
+    return;
+
+  if (debug_index_cache)
+    printf_unfiltered ("index cache: deferring store for objfile %s\n",
+		       objfile_name (dwarf2_per_objfile->objfile));
+
+  /* Queue the objfile rather than its DWARF data, which reread_symbols
+     may destroy and recreate before the store happens.  */
+  struct objfile *objfile = dwarf2_per_objfile->objfile;
+  if (std::find (m_pending_stores.begin (), m_pending_stores.end (), objfile)
+      == m_pending_stores.end ())
+    m_pending_stores.push_back (objfile);
+  if (m_store_timer == 0)
+    m_store_timer = create_timer (0, index_cache_store_timer, this);
+}
+
+/* See dwarf-index-cache.h.  */
+
+void
+index_cache::flush_pending_stores ()
+{
+  if (m_store_timer != 0)
+    {
+      delete_timer (m_store_timer);
+      m_store_timer = 0;
+    }
+
+  std::vector<struct objfile *> pending;
+  std::swap (pending, m_pending_stores);
+
+  for (struct objfile *objfile : pending)
+    {
+      dwarf2_per_objfile *per_objfile = get_dwarf2_per_objfile (objfile);
+
+      if (per_objfile != nullptr)
+	store_now (per_objfile);
+    }
+}
+
+/* See dwarf-index-cache.h.  */
+
+void
+index_cache::objfile_freed (struct objfile *objfile)
+{
+  auto iter = std::find (m_pending_stores.begin (), m_pending_stores.end (),
+			 objfile);
+  if (iter == m_pending_stores.end ())
+    return;
+
+  m_pending_stores.erase (iter);
+
+  dwarf2_per_objfile *per_objfile = get_dwarf2_per_objfile (objfile);
+  if (per_objfile != nullptr)
+    store_now (per_objfile);
+}
+
+/* See dwarf-index-cache.h.  */
+
+void
+index_cache::store_now (struct dwarf2_per_objfile *dwarf2_per_objfile)
 {
   objfile *obj = dwarf2_per_objfile->objfile;
 
@@ -128,6 +209,9 @@ index_cache::store (struct dwarf2_per_objfile *dwarf2_per_objfile)
          filename.  */
       write_psymtabs_to_index (dwarf2_per_objfile, m_dir.c_str (),
 			       build_id_str.c_str (), dw_index_kind::GDB_INDEX);
+
+      if (m_max_size >= 0)
+	evict (build_id_str + INDEX4_SUFFIX);
     }
   catch (const gdb_exception_error &except)
     {
@@ -137,6 +221,78 @@ index_cache::store (struct dwarf2_per_objfile *dwarf2_per_objfile)
     }
 }
 
+/* See dwarf-index-cache.h.  */
+
+void
+index_cache::evict (const std::string &keep)
+{
+  gdb_dir_up dir (opendir (m_dir.c_str ()));
+  if (dir == nullptr)
+    return;
+
+  /* An index file of the cache directory.  */
+  struct cache_file
+  {
+    std::string name;
+    time_t mtime;
+    off_t size;
+  };
+
+  std::vector<cache_file> files;
+  ULONGEST total_size = 0;
+  const size_t suffix_len = strlen (INDEX4_SUFFIX);
+  struct dirent *ent;
+
+  while ((ent = readdir (dir.get ())) != nullptr)
+    {
+      size_t len = strlen (ent->d_name);
+
+      if (len <= suffix_len
+	  || strcmp (ent->d_name + len - suffix_len, INDEX4_SUFFIX) != 0)
+	continue;
+
+      std::string filename = m_dir + SLASH_STRING + ent->d_name;
+      struct stat st;
+
+      if (stat (filename.c_str (), &st) != 0 || !S_ISREG (st.st_mode))
+	continue;
+
+      total_size += st.st_size;
+      if (keep != ent->d_name)
+	files.push_back ({ent->d_name, st.st_mtime, st.st_size});
+    }
+
+  /* Lookups touch the files they use, so the least recently used files
+     are the ones with the oldest modification time.  */
+  std::sort (files.begin (), files.end (),
+	     [] (const cache_file &a, const cache_file &b)
+	     {
+	       return a.mtime < b.mtime;
+	     });
+
+  for (const cache_file &file : files)
+    {
+      if (total_size <= (ULONGEST) m_max_size)
+	break;
+
+      std::string filename = m_dir + SLASH_STRING + file.name;
+
+      if (debug_index_cache)
+	printf_unfiltered ("index cache: evicting %s\n", filename.c_str ());
+
+      /* Another GDB may be using this file; unlinking it is still fine,
+	 its mapping stays valid.  The file may also have been evicted by
+	 another GDB in the meantime.  */
+      if (unlink (filename.c_str ()) == 0)
+	{
+	  total_size -= file.size;
+	  m_n_evictions++;
+	}
+      else if (errno == ENOENT)
+	total_size -= file.size;
+    }
+}
+
 #if HAVE_SYS_MMAN_H
 
 /* Hold the resources for an mmapped index file.  */
@@ -183,6 +339,11 @@ index_cache::lookup_gdb_index (const bfd_build_id *build_id,
 
       /* Yay, it worked!  Hand the resource to the caller.  */
       resource->reset (mmap_resource);
+      m_n_bytes_mapped += mmap_resource->mapping.size ();
+
+      /* Mark the file as recently used, so that it is evicted last.
+	 This is only a hint, so ignore failures.  */
+      utime (filename.c_str (), NULL);
 
       return gdb::array_view<const gdb_byte>
 	  ((const gdb_byte *) mmap_resource->mapping.get (),
@@ -300,6 +461,55 @@ show_index_cache_stats_command (const char *arg, int from_tty)
 		     indent, global_index_cache.n_hits ());
   printf_unfiltered (_("%sCache misses (this session): %u\n"),
 		     indent, global_index_cache.n_misses ());
+  printf_unfiltered (_("%sBytes mapped (this session): %s\n"),
+		     indent, pulongest (global_index_cache.n_bytes_mapped ()));
+  printf_unfiltered (_("%s   Evictions (this session): %u\n"),
+		     indent, global_index_cache.n_evictions ());
+}
+
+/* "set index-cache max-size" handler.  */
+
+static void
+set_index_cache_max_size_command (const char *arg, int from_tty,
+				  cmd_list_element *element)
+{
+  if (index_cache_max_size < 0)
+    global_index_cache.set_max_size (-1);
+  else
+    global_index_cache.set_max_size ((LONGEST) index_cache_max_size
+				     * 1024 * 1024);
+}
+
+/* "show index-cache max-size" handler.  */
+
+static void
+show_index_cache_max_size_command (struct ui_file *file, int from_tty,
+				   struct cmd_list_element *c,
+				   const char *value)
+{
+  if (index_cache_max_size < 0)
+    fprintf_filtered (file, _("The maximum size of the index cache "
+			      "is unlimited.\n"));
+  else
+    fprintf_filtered (file, _("The maximum size of the index cache "
+			      "is %s megabytes.\n"), value);
+}
+
+/* free_objfile observer.  */
+
+static void
+index_cache_free_objfile (struct objfile *objfile)
+{
+  global_index_cache.objfile_freed (objfile);
+}
+
+/* Final cleanup writing the indices that are still pending when GDB
+   exits.  */
+
+static void
+flush_index_cache_stores (void *)
+{
+  global_index_cache.flush_pending_stores ();
 }
 
 void
@@ -342,11 +552,29 @@ _initialize_index_cache ()
 			    &set_index_cache_prefix_list,
 			    &show_index_cache_prefix_list);
 
+  /* set index-cache max-size */
+  add_setshow_zuinteger_unlimited_cmd ("max-size", class_files,
+				       &index_cache_max_size, _("\
+Set the maximum size of the index cache, in megabytes."), _("\
+Show the maximum size of the index cache, in megabytes."), _("\
+When the index files in the cache directory take up more than this,\n\
+the least recently used ones are removed when a new index is stored.\n\
+\"unlimited\" means there is no limit."),
+				       set_index_cache_max_size_command,
+				       show_index_cache_max_size_command,
+				       &set_index_cache_prefix_list,
+				       &show_index_cache_prefix_list);
+
   /* show index-cache stats */
   add_cmd ("stats", class_files, show_index_cache_stats_command,
 	   _("Show some stats about the index cache."),
 	   &show_index_cache_prefix_list);
 
+  /* Don't lose the indices not written yet when their objfile goes
+     away, or when GDB exits.  */
+  gdb::observers::free_objfile.attach (index_cache_free_objfile);
+  make_final_cleanup (flush_index_cache_stores, NULL);
+
   /* set debug index-cache */
   add_setshow_boolean_cmd ("index-cache", class_maintenance,
 			   &debug_index_cache,
@@ -52,9 +52,24 @@ public:
   /* Disable the cache.  */
   void disable ();
 
-  /* Store an index for the specified object file in the cache.  */
+  /* Arrange for an index for the specified object file to be stored in
+     the cache.  The index is only written once GDB gets back to its
+     event loop, so that writing it does not delay the reading of the
+     symbols.  */
   void store (struct dwarf2_per_objfile *dwarf2_per_objfile);
 
+  /* Set the maximum total size, in bytes, of the index files in the
+     cache directory.  A negative value means there is no limit.  */
+  void set_max_size (LONGEST max_size)
+  { m_max_size = max_size; }
+
+  /* Write the indices whose storing was deferred by STORE.  */
+  void flush_pending_stores ();
+
+  /* Called when OBJFILE is about to be freed.  If storing its index is
+     still pending, write the index now.  */
+  void objfile_freed (struct objfile *objfile);
+
   /* Look for an index file matching BUILD_ID.  If found, return the contents
      as an array_view and store the underlying resources (allocated memory,
      mapped file, etc) in RESOURCE.  The returned array_view is valid as long
@@ -87,8 +102,24 @@ public:
       m_n_misses++;
   }
 
+  /* Return the number of bytes of cached index files mapped.  */
+  ULONGEST n_bytes_mapped () const
+  { return m_n_bytes_mapped; }
+
+  /* Return the number of index files evicted from the cache.  */
+  unsigned int n_evictions () const
+  { return m_n_evictions; }
+
 private:
 
+  /* Write an index for the specified object file to the cache.  */
+  void store_now (struct dwarf2_per_objfile *dwarf2_per_objfile);
+
+  /* Remove the least recently used index files from the cache directory
+     until their total size is within the maximum size.  KEEP is the
+     base name of the index file just stored, which is never removed.  */
+  void evict (const std::string &keep);
+
   /* Compute the absolute filename where the index of the objfile with build
      id BUILD_ID will be stored.  SUFFIX is appended at the end of the
      filename.  */
@@ -101,9 +132,26 @@ private:
   /* Whether the cache is enabled.  */
   bool m_enabled = false;
 
+  /* The maximum total size of the index files in the directory, in
+     bytes, or -1 if there is no limit.  */
+  LONGEST m_max_size = -1;
+
   /* Number of cache hits and misses during this GDB session.  */
   unsigned int m_n_hits = 0;
   unsigned int m_n_misses = 0;
+
+  /* Number of bytes of index files mapped, and number of index files
+     evicted, during this GDB session.  */
+  ULONGEST m_n_bytes_mapped = 0;
+  unsigned int m_n_evictions = 0;
+
+  /* The objfiles whose index is waiting to be written to the cache.
+     Their DWARF data is looked up when the index is written.  */
+  std::vector<struct objfile *> m_pending_stores;
+
+  /* The event loop timer that writes the pending indices, or 0 if none
+     is armed.  */
+  int m_store_timer = 0;
 };
 
 /* The global instance of the index cache.  */
@@ -2186,6 +2186,9 @@ dwarf2_per_objfile::~dwarf2_per_objfile ()
   if (line_header_hash)
     htab_delete (line_header_hash);
 
+  if (canonical_names)
+    htab_delete (canonical_names);
+
   for (dwarf2_per_cu_data *per_cu : all_comp_units)
     VEC_free (dwarf2_per_cu_ptr, per_cu->imported_symtabs);
 
@@ -4101,6 +4104,80 @@ dw2_lookup_symbol (struct objfile *objfile, int block_index,
   return stab_best;
 }
 
+/* die_reader_func for dw2_per_cu_language.  DATA points to the
+   language to set, which is left alone when the unit does not say what
+   its language is.  */
+
+static void
+dw2_per_cu_language_reader (const struct die_reader_specs *reader,
+			    const gdb_byte *info_ptr,
+			    struct die_info *comp_unit_die,
+			    int has_children,
+			    void *data)
+{
+  struct dwarf2_cu *cu = reader->cu;
+  enum language *language = (enum language *) data;
+
+  /* The language of a partial unit is the one of the unit importing
+     it, and a skeleton unit may leave it to the DWO file.  */
+  if (comp_unit_die->tag == DW_TAG_partial_unit
+      || dwarf2_attr (comp_unit_die, DW_AT_language, cu) == NULL)
+    return;
+
+  prepare_one_comp_unit (cu, comp_unit_die, language_minimal);
+  *language = cu->language;
+}
+
+/* Return the language of PER_CU, reading only its top-level DIE if
+   it is not loaded yet, or language_unknown if it cannot be told that
+   way.  */
+
+static enum language
+dw2_per_cu_language (struct dwarf2_per_cu_data *per_cu)
+{
+  /* init_cutu_and_read_dies_simple can't be used on a loaded unit.  */
+  if (per_cu->cu != NULL)
+    return per_cu->cu->language;
+
+  enum language language = language_unknown;
+
+  if (!per_cu->is_debug_types)
+    init_cutu_and_read_dies_simple (per_cu, dw2_per_cu_language_reader,
+				    &language);
+  return language;
+}
+
+/* Index version of lookup_global_symbol_language.  See its definition
+   in the definition of quick_symbol_functions in symfile.h.  */
+
+static enum language
+dw2_lookup_global_symbol_language (struct objfile *objfile, const char *name,
+				   domain_enum domain, bool *symbol_found_p)
+{
+  struct dwarf2_per_objfile *dwarf2_per_objfile
+    = get_dwarf2_per_objfile (objfile);
+  struct dw2_symtab_iterator iter;
+  struct dwarf2_per_cu_data *per_cu;
+
+  *symbol_found_p = false;
+
+  dw2_symtab_iter_init (&iter, dwarf2_per_objfile, 1, GLOBAL_BLOCK, domain,
+			name);
+
+  while ((per_cu = dw2_symtab_iter_next (&iter)) != NULL)
+    {
+      enum language language = dw2_per_cu_language (per_cu);
+
+      if (language != language_unknown)
+	{
+	  *symbol_found_p = true;
+	  return language;
+	}
+    }
+
+  return language_unknown;
+}
+
 static void
 dw2_print_stats (struct objfile *objfile)
 {
@@ -4566,8 +4643,20 @@ dw2_expand_symtabs_matching_symbol
   std::vector<offset_type> matches;
   matches.reserve (std::distance (bounds.first, bounds.second));
 
+  /* If the range covers the whole table, e.g. when the lookup name
+     matches anything, every symbol name appears in it once as a
+     whole.  Only consider that entry, so that the matchers, which may
+     be expensive, are called once per symbol rather than once per
+     name component.  */
+  bool whole_names_only
+    = (bounds.first == index.name_components.begin ()
+       && bounds.second == index.name_components.end ());
+
   for (; bounds.first != bounds.second; ++bounds.first)
     {
+      if (whole_names_only && bounds.first->name_offset != 0)
+	continue;
+
       const char *qualified = index.symbol_name_at (bounds.first->idx);
 
       if (!lookup_name_matcher.matches (qualified)
@@ -5374,6 +5463,7 @@ const struct quick_symbol_functions dwarf2_gdb_index_functions =
   dw2_forget_cached_source_info,
   dw2_map_symtabs_matching_filename,
   dw2_lookup_symbol,
+  dw2_lookup_global_symbol_language,
   dw2_print_stats,
   dw2_dump,
   dw2_expand_symtabs_for_function,
@@ -5995,6 +6085,9 @@ dw2_debug_names_iterator::next ()
 	{
 	case DW_TAG_typedef:
 	case DW_TAG_structure_type:
+	case DW_TAG_class_type:
+	case DW_TAG_union_type:
+	case DW_TAG_enumeration_type:
 	  break;
 	default:
 	  goto again;
@@ -6041,6 +6134,9 @@ dw2_debug_names_iterator::next ()
 	{
 	case DW_TAG_typedef:
 	case DW_TAG_structure_type:
+	case DW_TAG_class_type:
+	case DW_TAG_union_type:
+	case DW_TAG_enumeration_type:
 	  break;
 	default:
 	  goto again;
@@ -6102,6 +6198,47 @@ dw2_debug_names_lookup_symbol (struct objfile *objfile, int block_index_int,
   return stab_best;
 }
 
+/* .debug_names version of lookup_global_symbol_language.  See its
+   definition in the definition of quick_symbol_functions in
+   symfile.h.  */
+
+static enum language
+dw2_debug_names_lookup_global_symbol_language (struct objfile *objfile,
+					       const char *name,
+					       domain_enum domain,
+					       bool *symbol_found_p)
+{
+  struct dwarf2_per_objfile *dwarf2_per_objfile
+    = get_dwarf2_per_objfile (objfile);
+
+  *symbol_found_p = false;
+
+  const auto &mapp = dwarf2_per_objfile->debug_names_table;
+  if (!mapp)
+    {
+      /* index is NULL if OBJF_READNOW.  */
+      return language_unknown;
+    }
+  const auto &map = *mapp;
+
+  dw2_debug_names_iterator iter (map, true /* want_specific_block */,
+				 GLOBAL_BLOCK, domain, name);
+
+  struct dwarf2_per_cu_data *per_cu;
+  while ((per_cu = iter.next ()) != NULL)
+    {
+      enum language language = dw2_per_cu_language (per_cu);
+
+      if (language != language_unknown)
+	{
+	  *symbol_found_p = true;
+	  return language;
+	}
+    }
+
+  return language_unknown;
+}
+
 /* This dumps minimal information about .debug_names.  It is called
    via "mt print objfiles".  The gdb.dwarf2/gdb-index.exp testcase
    uses this to verify that .debug_names has been loaded.  */
@@ -6185,6 +6322,7 @@ const struct quick_symbol_functions dwarf2_debug_names_functions =
   dw2_forget_cached_source_info,
   dw2_map_symtabs_matching_filename,
   dw2_debug_names_lookup_symbol,
+  dw2_debug_names_lookup_global_symbol_language,
   dw2_print_stats,
   dw2_debug_names_dump,
   dw2_debug_names_expand_symtabs_for_function,
@@ -22691,6 +22829,37 @@ sibling_die (struct die_info *die)
   return die->sibling;
 }
 
+/* An entry in dwarf2_per_objfile::canonical_names.  */
+
+struct canonical_name_entry
+{
+  /* A name as found in the debug info, and its canonical form.  Both
+     are on the objfile's storage obstack, and may be the same
+     string.  */
+  const char *name;
+  const char *canonical;
+};
+
+static hashval_t
+hash_canonical_name_entry (const void *item)
+{
+  const struct canonical_name_entry *e
+    = (const struct canonical_name_entry *) item;
+
+  return htab_hash_string (e->name);
+}
+
+static int
+eq_canonical_name_entry (const void *item_lhs, const void *item_rhs)
+{
+  const struct canonical_name_entry *lhs
+    = (const struct canonical_name_entry *) item_lhs;
+  const struct canonical_name_entry *rhs
+    = (const struct canonical_name_entry *) item_rhs;
+
+  return strcmp (lhs->name, rhs->name) == 0;
+}
+
 /* Get name of a die, return NULL if not found.  */
 
 static const char *
@@ -22699,15 +22868,54 @@ dwarf2_canonicalize_name (const char *name, struct dwarf2_cu *cu,
 {
   if (name && cu->language == language_cplus)
     {
-      std::string canon_name = cp_canonicalize_string (name);
+      struct dwarf2_per_objfile *dwarf2_per_objfile
+	= cu->per_cu->dwarf2_per_objfile;
+      struct canonical_name_entry entry, **slot;
+      const char *p;
 
-      if (!canon_name.empty ())
+      /* Simple identifiers are dealt with quickly by
+	 cp_canonicalize_string.  Anything else, like the name of a
+	 template instance or an operator, means running the C++ name
+	 parser, and such names turn up in every CU that uses them, so
+	 remember the result.  */
+      for (p = name; isalnum ((unsigned char) *p) || *p == '_'; p++)
+	;
+      if (*p == '\0')
 	{
-	  if (canon_name != name)
+	  std::string canon_name = cp_canonicalize_string (name);
+
+	  if (!canon_name.empty () && canon_name != name)
 	    name = (const char *) obstack_copy0 (obstack,
 						 canon_name.c_str (),
 						 canon_name.length ());
+	  return name;
+	}
+
+      if (dwarf2_per_objfile->canonical_names == NULL)
+	dwarf2_per_objfile->canonical_names
+	  = htab_create_alloc (256, hash_canonical_name_entry,
+			       eq_canonical_name_entry, NULL,
+			       xcalloc, xfree);
+
+      entry.name = name;
+      slot = ((struct canonical_name_entry **)
+	      htab_find_slot (dwarf2_per_objfile->canonical_names,
+			      &entry, INSERT));
+      if (*slot == NULL)
+	{
+	  std::string canon_name = cp_canonicalize_string (name);
+
+	  *slot = XOBNEW (obstack, struct canonical_name_entry);
+	  (*slot)->name = (const char *) obstack_copy0 (obstack, name,
+							strlen (name));
+	  if (!canon_name.empty () && canon_name != name)
+	    (*slot)->canonical
+	      = (const char *) obstack_copy0 (obstack, canon_name.c_str (),
+					      canon_name.length ());
+	  else
+	    (*slot)->canonical = (*slot)->name;
 	}
+      name = (*slot)->canonical;
     }
 
   return name;
@@ -246,6 +246,10 @@ public:
   /* Table containing line_header indexed by offset and offset_in_dwz.  */
   htab_t line_header_hash {};
 
+  /* Table mapping C++ names that are not simple identifiers to their
+     canonical form.  See dwarf2_canonicalize_name.  */
+  htab_t canonical_names {};
+
   /* Table containing all filenames.  This is an optional because the
      table is lazily constructed on first access.  */
   gdb::optional<filename_seen_cache> filenames_cache;
@@ -149,6 +149,9 @@ struct linespec_state
      space.  */
   struct program_space *search_pspace;
 
+  /* If not NULL, the search is restricted to just these objfiles.  */
+  const std::vector<struct objfile *> *search_objfiles;
+
   /* The default symtab to use, if no other symtab is specified.  */
   struct symtab *default_symtab;
 
@@ -363,7 +366,8 @@ static std::vector<symtab_and_line> decode_objc (struct linespec_state *self,
 						 const char *arg);
 
 static std::vector<symtab *> symtabs_from_filename
-  (const char *, struct program_space *pspace);
+  (const char *, struct program_space *pspace,
+   const std::vector<struct objfile *> *objfiles);
 
 static std::vector<block_symbol> *find_label_symbols
   (struct linespec_state *self, std::vector<block_symbol> *function_symbols,
@@ -396,7 +400,8 @@ static void add_all_symbol_names_from_pspace
 
 static std::vector<symtab *>
   collect_symtabs_from_filename (const char *file,
-				 struct program_space *pspace);
+				 struct program_space *pspace,
+				 const std::vector<struct objfile *> *objfiles);
 
 static std::vector<symtab_and_line> decode_digits_ordinary
   (struct linespec_state *self,
@@ -1115,6 +1120,21 @@ maybe_add_address (htab_t set, struct program_space *pspace, CORE_ADDR addr)
   return 1;
 }
 
+/* Return true if the search described by STATE should look at the
+   symbols of OBJFILE.  */
+
+static bool
+objfile_searched_p (const struct linespec_state *state,
+		    struct objfile *objfile)
+{
+  if (state->search_objfiles == NULL)
+    return true;
+
+  return std::find (state->search_objfiles->begin (),
+		    state->search_objfiles->end (),
+		    objfile) != state->search_objfiles->end ();
+}
+
 /* A helper that walks over all matching symtabs in all objfiles and
    calls CALLBACK for each symbol matching NAME.  If SEARCH_PSPACE is
    not NULL, then the search is restricted to just that program
@@ -1143,6 +1163,9 @@ iterate_over_all_matching_symtabs
 
     for (objfile *objfile : current_program_space->objfiles ())
       {
+	if (!objfile_searched_p (state, objfile))
+	  continue;
+
 	if (objfile->sf)
 	  objfile->sf->qf->expand_symtabs_matching (objfile,
 						    NULL,
@@ -2103,7 +2126,8 @@ create_sals_line_offset (struct linespec_state *self,
       initialize_defaults (&self->default_symtab, &self->default_line);
       *ls->file_symtabs
 	= collect_symtabs_from_filename (self->default_symtab->filename,
-					 self->search_pspace);
+					 self->search_pspace,
+					 self->search_objfiles);
       use_default = 1;
     }
 
@@ -2386,7 +2410,8 @@ convert_explicit_location_to_linespec (struct linespec_state *self,
       try
 	{
 	  *result->file_symtabs
-	    = symtabs_from_filename (source_filename, self->search_pspace);
+	    = symtabs_from_filename (source_filename, self->search_pspace,
+				     self->search_objfiles);
 	}
       catch (const gdb_exception_error &except)
 	{
@@ -2611,7 +2636,8 @@ parse_linespec (linespec_parser *parser, const char *arg,
 	{
 	  *PARSER_RESULT (parser)->file_symtabs
 	    = symtabs_from_filename (user_filename.get (),
-				     PARSER_STATE (parser)->search_pspace);
+				     PARSER_STATE (parser)->search_pspace,
+				     PARSER_STATE (parser)->search_objfiles);
 	}
       catch (gdb_exception_error &ex)
 	{
@@ -3206,7 +3232,8 @@ decode_line_full (const struct event_location *location, int flags,
 		  struct symtab *default_symtab,
 		  int default_line, struct linespec_result *canonical,
 		  const char *select_mode,
-		  const char *filter)
+		  const char *filter,
+		  const std::vector<struct objfile *> *search_objfiles)
 {
   std::vector<const char *> filters;
   struct linespec_state *state;
@@ -3223,6 +3250,7 @@ decode_line_full (const struct event_location *location, int flags,
   linespec_parser parser (flags, current_language,
 			  search_pspace, default_symtab,
 			  default_line, canonical);
+  PARSER_STATE (&parser)->search_objfiles = search_objfiles;
 
   scoped_restore_current_program_space restore_pspace;
 
@@ -3775,16 +3803,32 @@ symtab_collector::operator () (struct symtab *symtab)
 
 /* Given a file name, return a list of all matching symtabs.  If
    SEARCH_PSPACE is not NULL, the search is restricted to just that
-   program space.  */
+   program space.  If SEARCH_OBJFILES is not NULL, the search is
+   restricted to just those objfiles.  */
 
 static std::vector<symtab *>
 collect_symtabs_from_filename (const char *file,
-			       struct program_space *search_pspace)
+			       struct program_space *search_pspace,
+			       const std::vector<struct objfile *>
+			         *search_objfiles)
 {
   symtab_collector collector;
 
   /* Find that file's data.  */
-  if (search_pspace == NULL)
+  if (search_objfiles != NULL)
+    {
+      for (objfile *objfile : *search_objfiles)
+	{
+	  if (search_pspace != NULL && objfile->pspace != search_pspace)
+	    continue;
+	  if (objfile->pspace->executing_startup)
+	    continue;
+
+	  set_current_program_space (objfile->pspace);
+	  iterate_over_symtabs (file, collector, objfile);
+	}
+    }
+  else if (search_pspace == NULL)
     {
       struct program_space *pspace;
 
@@ -3807,14 +3851,18 @@ collect_symtabs_from_filename (const char *file,
 }
 
 /* Return all the symtabs associated to the FILENAME.  If SEARCH_PSPACE is
-   not NULL, the search is restricted to just that program space.  */
+   not NULL, the search is restricted to just that program space.  If
+   SEARCH_OBJFILES is not NULL, the search is restricted to just those
+   objfiles.  */
 
 static std::vector<symtab *>
 symtabs_from_filename (const char *filename,
-		       struct program_space *search_pspace)
+		       struct program_space *search_pspace,
+		       const std::vector<struct objfile *> *search_objfiles)
 {
   std::vector<symtab *> result
-    = collect_symtabs_from_filename (filename, search_pspace);
+    = collect_symtabs_from_filename (filename, search_pspace,
+				     search_objfiles);
 
   if (result.empty ())
     {
@@ -4345,6 +4393,9 @@ search_minsyms_for_name (struct collect_info *info,
 
 	for (objfile *objfile : current_program_space->objfiles ())
 	  {
+	    if (!objfile_searched_p (info->state, objfile))
+	      continue;
+
 	    iterate_over_minimal_symbols (objfile, name,
 					  [&] (struct minimal_symbol *msym)
 					  {
@@ -122,14 +122,20 @@ extern std::vector<symtab_and_line>
    entry describing all the matching locations.  If FILTER is
    non-NULL, then only locations whose canonical name is equal (in the
    strcmp sense) to FILTER will be returned; all others will be
-   filtered out.  */
+   filtered out.
+
+   If SEARCH_OBJFILES is not NULL, symbols and source files are only
+   looked up in those objfiles.  This is used to find out whether
+   newly loaded objfiles could add locations to a breakpoint.  */
 
 extern void decode_line_full (const struct event_location *location, int flags,
 			      struct program_space *search_pspace,
 			      struct symtab *default_symtab, int default_line,
 			      struct linespec_result *canonical,
 			      const char *select_mode,
-			      const char *filter);
+			      const char *filter,
+			      const std::vector<struct objfile *>
+			        *search_objfiles = NULL);
 
 /* Given a string, return the line specified by it, using the current
    source symtab and line as defaults.
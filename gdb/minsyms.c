@@ -1140,7 +1140,23 @@ minimal_symbol_reader::record_full (const char *name, int name_len,
   msymbol = &m_msym_bunch->contents[m_msym_bunch_index];
   symbol_set_language (msymbol, language_auto,
 		       &m_objfile->per_bfd->storage_obstack);
-  symbol_set_names (msymbol, name, name_len, copy_name, m_objfile->per_bfd);
+
+  /* Only the linkage name is recorded here; the language and the
+     demangled name are computed by install, once the duplicates have
+     been compacted out.  */
+  if (copy_name || name[name_len] != '\0')
+    {
+      char *name_copy
+	= (char *) obstack_alloc (&m_objfile->per_bfd->storage_obstack,
+				  name_len + 1);
+
+      memcpy (name_copy, name, name_len);
+      name_copy[name_len] = '\0';
+      msymbol->name = name_copy;
+    }
+  else
+    msymbol->name = name;
+  msymbol->name_set = 0;
 
   SET_MSYMBOL_VALUE_ADDRESS (msymbol, address);
   MSYMBOL_SECTION (msymbol) = section;
@@ -1360,6 +1376,24 @@ minimal_symbol_reader::install ()
 				     msym_holder.release (),
 				     mcount));
 
+      /* Now demangle and intern the names of the new minimal symbols.
+	 Doing this after compaction means that a symbol which appears
+	 in several symbol tables (e.g. both the ELF .symtab and .dynsym)
+	 only has its name looked up once.  */
+
+      msymbols = msym_holder.get ();
+      for (int i = 0; i < mcount; i++)
+	{
+	  struct minimal_symbol *msym = &msymbols[i];
+
+	  if (!msym->name_set)
+	    {
+	      symbol_set_names (msym, msym->name, strlen (msym->name), 0,
+				m_objfile->per_bfd);
+	      msym->name_set = 1;
+	    }
+	}
+
       /* Attach the minimal symbol table to the specified objfile.
          The strings themselves are also located in the storage_obstack
          of this objfile.  */
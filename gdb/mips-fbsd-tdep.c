@@ -480,6 +480,7 @@ mips_fbsd_ilp32_fetch_link_map_offsets (void)
       lmo.r_version_size = 4;
       lmo.r_map_offset = 4;
       lmo.r_brk_offset = 8;
+      lmo.r_state_offset = 12;
       lmo.r_ldsomap_offset = -1;
 
       lmo.link_map_size = 24;
@@ -507,6 +508,7 @@ mips_fbsd_lp64_fetch_link_map_offsets (void)
       lmo.r_version_size = 4;
       lmo.r_map_offset = 8;
       lmo.r_brk_offset = 16;
+      lmo.r_state_offset = 24;
       lmo.r_ldsomap_offset = -1;
 
       lmo.link_map_size = 48;
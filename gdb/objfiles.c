@@ -797,9 +797,10 @@ objfile_relocate1 (struct objfile *objfile,
       }
   }
 
-  /* This stores relocated addresses and so must be cleared.  This
-     will cause it to be recreated on demand.  */
+  /* These store relocated addresses and so must be cleared.  This
+     will cause them to be recreated on demand.  */
   objfile->psymbol_map.clear ();
+  objfile->compunit_map.clear ();
 
   /* Relocate isolated symbols.  */
   {
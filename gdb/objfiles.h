@@ -224,6 +224,45 @@ private:
   struct minimal_symbol *m_msym;
 };
 
+/* A table of the PC ranges covered by the expanded compunit symtabs
+   of an objfile, sorted by start address.  It is used by
+   find_pc_sect_compunit_symtab to avoid walking every compunit, and is
+   updated lazily as compunits are added to the objfile.  */
+
+struct compunit_pc_map
+{
+  struct entry
+  {
+    /* The range of the compunit's global block.  */
+    CORE_ADDR start;
+    CORE_ADDR end;
+
+    /* The largest END of this entry and of all preceding entries.  */
+    CORE_ADDR max_end;
+
+    /* The order in which the compunit was added to the objfile.
+       Compunits are added to the front of the objfile's list, so a
+       larger value means the compunit comes earlier in the list.  */
+    unsigned int seq;
+
+    struct compunit_symtab *cust;
+  };
+
+  /* Forget all the entries.  */
+
+  void clear ()
+  {
+    entries.clear ();
+    head = nullptr;
+  }
+
+  std::vector<entry> entries;
+
+  /* The first compunit of the objfile's list when ENTRIES was last
+     updated.  The compunits in front of it are not in ENTRIES yet.  */
+  struct compunit_symtab *head = nullptr;
+};
+
 /* Some objfile data is hung off the BFD.  This enables sharing of the
    data across all objfiles using the BFD.  The data is stored in an
    instance of this structure, and associated with the BFD using the
@@ -520,6 +559,10 @@ struct objfile
 
   std::vector<std::pair<CORE_ADDR, partial_symtab *>> psymbol_map;
 
+  /* Map PC ranges to the expanded compunit symtabs covering them.  */
+
+  compunit_pc_map compunit_map;
+
   /* Structure which keeps track of functions that manipulate objfile's
      of the same type as this objfile.  I.e. the function to read partial
      symbols for example.  Note that this structure is in statically
@@ -45,6 +45,7 @@
 #include "auxv.h"
 #include "gdb_bfd.h"
 #include "probe.h"
+#include "gdbcmd.h"
 
 static struct link_map_offsets *svr4_fetch_link_map_offsets (void);
 static int svr4_have_link_map_offsets (void);
@@ -133,6 +134,22 @@ static const struct probe_info probe_info[] =
   { "unmap_complete", FULL_RELOAD },
 };
 
+/* When zero, the dynamic linker's probes are never used, and GDB
+   always falls back to the original r_brk interface.  */
+
+static int svr4_use_probes = 1;
+
+/* Implement "maint show solib-svr4-probes".  */
+
+static void
+show_svr4_use_probes (struct ui_file *file, int from_tty,
+		      struct cmd_list_element *c, const char *value)
+{
+  fprintf_filtered (file,
+		    _("Use of the dynamic linker's probes is %s.\n"),
+		    value);
+}
+
 #define NUM_PROBES ARRAY_SIZE (probe_info)
 
 /* Return non-zero if GDB_SO_NAME and INFERIOR_SO_NAME represent
@@ -355,9 +372,15 @@ struct svr4_info
      probe_and_action->prob->address.  */
   htab_up probes_table;
 
-  /* List of objects loaded into the inferior, used by the probes-
-     based interface.  */
+  /* List of objects loaded into the inferior, maintained by
+     svr4_handle_solib_event.  */
   struct so_list *solib_list = nullptr;
+
+  /* True if, when not using the probes-based interface, the next
+     update of SOLIB_LIST must read the whole list, because the dynamic
+     linker may have removed or reordered objects since it was last
+     read in full.  See svr4_update_solib_list_at_r_brk.  */
+  bool solib_list_full_read_needed = true;
 };
 
 /* Per-program-space data key.  */
@@ -885,6 +908,45 @@ solib_svr4_r_brk (struct svr4_info *info)
 				    ptr_type);
 }
 
+/* The values of r_debug.r_state.  */
+
+enum svr4_r_state
+  {
+    /* The list of loaded objects is consistent.  */
+    SVR4_RT_CONSISTENT = 0,
+
+    /* The dynamic linker is about to add objects to the list.  */
+    SVR4_RT_ADD = 1,
+
+    /* The dynamic linker is about to remove objects from the list.  */
+    SVR4_RT_DELETE = 2
+  };
+
+/* Find r_state from the inferior's debug base.  Return -1 if it
+   could not be read.  */
+
+static int
+solib_svr4_r_state (struct svr4_info *info)
+{
+  struct link_map_offsets *lmo = svr4_fetch_link_map_offsets ();
+  enum bfd_endian byte_order = gdbarch_byte_order (target_gdbarch ());
+
+  if (lmo->r_state_offset == -1)
+    return -1;
+
+  try
+    {
+      return read_memory_integer (info->debug_base + lmo->r_state_offset,
+				  4, byte_order);
+    }
+  catch (const gdb_exception_error &ex)
+    {
+      exception_print (gdb_stderr, ex);
+    }
+
+  return -1;
+}
+
 /* Find the link map for the dynamic linker (if it is not in the
    normal list of loaded shared objects).  */
 
@@ -1439,8 +1501,9 @@ svr4_current_sos_direct (struct svr4_info *info)
 static struct so_list *
 svr4_current_sos_1 (svr4_info *info)
 {
-  /* If the solib list has been read and stored by the probes
-     interface then we return a copy of the stored list.  */
+  /* If the solib list has been read and stored by
+     svr4_handle_solib_event then we return a copy of the stored
+     list.  */
   if (info->solib_list != NULL)
     return svr4_copy_library_list (info->solib_list);
 
@@ -1850,6 +1913,81 @@ solist_update_incremental (struct svr4_info *info, CORE_ADDR lm)
   return 1;
 }
 
+/* Update the shared object list by reading the objects that follow
+   the last one we know about, if any.  Returns nonzero if the list
+   was successfully updated, or zero to indicate failure.  */
+
+static int
+solist_update_appended (struct svr4_info *info)
+{
+  struct so_list *tail;
+
+  /* See solist_update_incremental.  */
+  if (info->solib_list == NULL)
+    return 0;
+
+  /* svr4_current_sos_direct puts the dynamic linker's own list after
+     the main one, so the last object is not at the end of the main
+     list.  */
+  if (solib_svr4_r_ldsomap (info) != 0)
+    return 0;
+
+  /* Walk to the end of the list.  */
+  for (tail = info->solib_list; tail->next != NULL; tail = tail->next)
+    /* Nothing.  */;
+
+  /* This is not a real list entry; see svr4_default_sos.  */
+  lm_info_svr4 *li = (lm_info_svr4 *) tail->lm_info;
+  if (li->lm_addr == 0)
+    return 0;
+
+  std::unique_ptr<lm_info_svr4> tail_li = lm_info_read (li->lm_addr);
+  if (tail_li == NULL)
+    return 0;
+
+  if (tail_li->l_next == 0)
+    return 1;
+
+  return solist_update_incremental (info, tail_li->l_next);
+}
+
+/* Update the shared object list when stopped at r_brk, i.e., when not
+   using the probes-based interface.  Once the program has started,
+   the dynamic linker only appends objects to its list, except between
+   the stops where r_state is RT_DELETE and RT_CONSISTENT.  Outside of
+   those, only the objects following the last one we know about need
+   to be read, which saves rereading the whole list from the inferior
+   at every stop.  */
+
+static void
+svr4_update_solib_list_at_r_brk (struct svr4_info *info)
+{
+  int r_state = -1;
+
+  if (locate_base (info) != 0)
+    r_state = solib_svr4_r_state (info);
+
+  if (r_state == -1)
+    {
+      /* We can't tell what changed, so let svr4_current_sos read the
+	 whole list.  */
+      free_solib_list (info);
+      return;
+    }
+
+  if (r_state == SVR4_RT_DELETE)
+    info->solib_list_full_read_needed = true;
+
+  if (info->solib_list_full_read_needed || !solist_update_appended (info))
+    solist_update_full (info);
+
+  /* The dynamic linker sets up the initial list while starting up,
+     moving itself around in it, so incremental updates are only
+     possible after a full read of a consistent list.  */
+  if (r_state == SVR4_RT_CONSISTENT)
+    info->solib_list_full_read_needed = false;
+}
+
 /* Disable the probes-based linker interface and revert to the
    original interface.  We don't reset the breakpoints as the
    ones set up for the probes-based interface are adequate.  */
@@ -1864,9 +2002,8 @@ disable_probes_interface (svr4_info *info)
   free_solib_list (info);
 }
 
-/* Update the solib list as appropriate when using the
-   probes-based linker interface.  Do nothing if using the
-   standard interface.  */
+/* Update the solib list as appropriate after a shared library
+   event.  */
 
 static void
 svr4_handle_solib_event (void)
@@ -1878,9 +2015,11 @@ svr4_handle_solib_event (void)
   CORE_ADDR pc, debug_base, lm = 0;
   struct frame_info *frame = get_current_frame ();
 
-  /* Do nothing if not using the probes interface.  */
   if (info->probes_table == NULL)
-    return;
+    {
+      svr4_update_solib_list_at_r_brk (info);
+      return;
+    }
 
   /* If anything goes wrong we revert to the original linker
      interface.  */
@@ -2080,7 +2219,7 @@ svr4_create_solib_event_breakpoints (svr4_info *info, struct gdbarch *gdbarch,
   struct obj_section *os;
 
   os = find_pc_section (address);
-  if (os != NULL)
+  if (os != NULL && svr4_use_probes)
     {
       int with_prefix;
 
@@ -3000,9 +3139,11 @@ svr4_solib_create_inferior_hook (int from_tty)
 
   info = get_svr4_info (current_program_space);
 
-  /* Clear the probes-based interface's state.  */
+  /* Clear the probes-based interface's state, and the list of
+     objects kept across shared library events.  */
   free_probes_table (info);
   free_solib_list (info);
+  info->solib_list_full_read_needed = true;
 
   /* Relocate the main executable if necessary.  */
   svr4_relocate_main_executable ();
@@ -3030,6 +3171,8 @@ svr4_clear_solib (void)
   info->debug_loader_offset = 0;
   xfree (info->debug_loader_name);
   info->debug_loader_name = NULL;
+  free_solib_list (info);
+  info->solib_list_full_read_needed = true;
 }
 
 /* Clear any bits of ADDR that wouldn't fit in a target-format
@@ -3154,6 +3297,7 @@ svr4_ilp32_fetch_link_map_offsets (void)
       lmo.r_version_size = 4;
       lmo.r_map_offset = 4;
       lmo.r_brk_offset = 8;
+      lmo.r_state_offset = 12;
       lmo.r_ldsomap_offset = 20;
 
       /* Everything we need is in the first 20 bytes.  */
@@ -3185,6 +3329,7 @@ svr4_lp64_fetch_link_map_offsets (void)
       lmo.r_version_size = 4;
       lmo.r_map_offset = 8;
       lmo.r_brk_offset = 16;
+      lmo.r_state_offset = 24;
       lmo.r_ldsomap_offset = 40;
 
       /* Everything we need is in the first 40 bytes.  */
@@ -3250,4 +3395,17 @@ _initialize_svr4_solib (void)
   svr4_so_ops.handle_event = svr4_handle_solib_event;
 
   gdb::observers::free_objfile.attach (svr4_free_objfile_observer);
+
+  add_setshow_boolean_cmd ("solib-svr4-probes", class_maintenance,
+			   &svr4_use_probes, _("\
+Set whether GDB uses the dynamic linker's probes."), _("\
+Show whether GDB uses the dynamic linker's probes."), _("\
+When on, GDB tracks shared library events using the probes in the\n\
+dynamic linker, if there are any.  When off, GDB always uses the\n\
+original debugger interface.  The setting takes effect the next time\n\
+the shared library event breakpoints are created."),
+			   NULL,
+			   show_svr4_use_probes,
+			   &maintenance_set_cmdlist,
+			   &maintenance_show_cmdlist);
 }
@@ -1006,8 +1006,10 @@ solib_add (const char *pattern, int from_tty, int readsyms)
 	    }
 	}
 
+    /* Breakpoints only need to be looked up in the objfiles added
+       since they were last re-set.  */
     if (loaded_any_symbols)
-      breakpoint_re_set ();
+      breakpoint_re_set_new_objfiles ();
 
     if (from_tty && pattern && ! any_matches)
       printf_unfiltered
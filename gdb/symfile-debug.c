@@ -163,6 +163,32 @@ debug_qf_lookup_symbol (struct objfile *objfile, int kind, const char *name,
   return retval;
 }
 
+static enum language
+debug_qf_lookup_global_symbol_language (struct objfile *objfile,
+					const char *name, domain_enum domain,
+					bool *symbol_found_p)
+{
+  const struct debug_sym_fns_data *debug_data
+    = symfile_debug_objfile_data_key.get (objfile);
+
+  fprintf_filtered (gdb_stdlog,
+		    "qf->lookup_global_symbol_language (%s, \"%s\", %s)\n",
+		    objfile_debug_name (objfile), name,
+		    domain_name (domain));
+
+  enum language lang = language_unknown;
+  *symbol_found_p = false;
+  if (debug_data->real_sf->qf->lookup_global_symbol_language != NULL)
+    lang = (debug_data->real_sf->qf->lookup_global_symbol_language
+	    (objfile, name, domain, symbol_found_p));
+
+  fprintf_filtered (gdb_stdlog,
+		    "qf->lookup_global_symbol_language (...) = %s, %d\n",
+		    language_str (lang), *symbol_found_p);
+
+  return lang;
+}
+
 static void
 debug_qf_print_stats (struct objfile *objfile)
 {
@@ -368,6 +394,7 @@ static const struct quick_symbol_functions debug_sym_quick_functions =
   debug_qf_forget_cached_source_info,
   debug_qf_map_symtabs_matching_filename,
   debug_qf_lookup_symbol,
+  debug_qf_lookup_global_symbol_language,
   debug_qf_print_stats,
   debug_qf_dump,
   debug_qf_expand_symtabs_for_function,
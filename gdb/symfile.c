@@ -2570,6 +2570,7 @@ reread_symbols (void)
 	  obstack_free (&objfile->objfile_obstack, 0);
 	  objfile->sections = NULL;
 	  objfile->compunit_symtabs = NULL;
+	  objfile->compunit_map.clear ();
 	  objfile->template_symbols = NULL;
 	  objfile->static_links.reset (nullptr);
 
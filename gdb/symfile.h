@@ -182,6 +182,18 @@ struct quick_symbol_functions
 					    int block_index, const char *name,
 					    domain_enum domain);
 
+  /* Check to see if the global symbol NAME is defined in a "partial"
+     symbol table of OBJFILE, without expanding any symbol table.
+     DOMAIN indicates what sort of symbol to search for.
+
+     If the symbol is found and its language is known, set
+     *SYMBOL_FOUND_P to true and return the language.  Otherwise set
+     *SYMBOL_FOUND_P to false.  SYMBOL_FOUND_P must not be NULL.  */
+  enum language (*lookup_global_symbol_language) (struct objfile *objfile,
+						  const char *name,
+						  domain_enum domain,
+						  bool *symbol_found_p);
+
   /* Print statistics about any indices loaded for OBJFILE.  The
      statistics should be printed to gdb_stdout.  This is used for
      "maint print statistics".  */
@@ -495,11 +495,13 @@ iterate_over_some_symtabs (const char *name,
    in the symtab filename will also work.
 
    Calls CALLBACK with each symtab that is found.  If CALLBACK returns
-   true, the search stops.  */
+   true, the search stops.  If ONLY_OBJFILE is not NULL, only the
+   symtabs of that objfile are searched.  */
 
 void
 iterate_over_symtabs (const char *name,
-		      gdb::function_view<bool (symtab *)> callback)
+		      gdb::function_view<bool (symtab *)> callback,
+		      struct objfile *only_objfile)
 {
   gdb::unique_xmalloc_ptr<char> real_path;
 
@@ -513,6 +515,9 @@ iterate_over_symtabs (const char *name,
 
   for (objfile *objfile : current_program_space->objfiles ())
     {
+      if (only_objfile != NULL && objfile != only_objfile)
+	continue;
+
       if (iterate_over_some_symtabs (name, real_path.get (),
 				     objfile->compunit_symtabs, NULL,
 				     callback))
@@ -524,6 +529,9 @@ iterate_over_symtabs (const char *name,
 
   for (objfile *objfile : current_program_space->objfiles ())
     {
+      if (only_objfile != NULL && objfile != only_objfile)
+	continue;
+
       if (objfile->sf
 	  && objfile->sf->qf->map_symtabs_matching_filename (objfile,
 							     name,
@@ -713,6 +721,13 @@ symbol_set_language (struct general_symbol_info *gsymbol,
 struct demangled_name_entry
 {
   const char *mangled;
+  /* The hash of MANGLED, so that growing the table does not have to
+     rehash every name.  */
+  hashval_t hash;
+  /* The language symbol_find_demangled_name picks for a symbol of
+     unknown language with this name, or language_unknown if that has
+     not been worked out yet.  */
+  ENUM_BITFIELD(language) language : LANGUAGE_BITS;
   char demangled[1];
 };
 
@@ -724,7 +739,7 @@ hash_demangled_name_entry (const void *data)
   const struct demangled_name_entry *e
     = (const struct demangled_name_entry *) data;
 
-  return htab_hash_string (e->mangled);
+  return e->hash;
 }
 
 /* Equality function for the demangled name hash.  */
@@ -737,7 +752,7 @@ eq_demangled_name_entry (const void *a, const void *b)
   const struct demangled_name_entry *db
     = (const struct demangled_name_entry *) b;
 
-  return strcmp (da->mangled, db->mangled) == 0;
+  return da->hash == db->hash && strcmp (da->mangled, db->mangled) == 0;
 }
 
 /* Create the hash table used for demangled names.  Each hash entry is
@@ -853,15 +868,32 @@ symbol_set_names (struct general_symbol_info *gsymbol,
   else
     linkage_name_copy = linkage_name;
 
-  /* Set the symbol language.  */
-  char *demangled_name_ptr
-    = symbol_find_demangled_name (gsymbol, linkage_name_copy);
-  gdb::unique_xmalloc_ptr<char> demangled_name (demangled_name_ptr);
-
   entry.mangled = linkage_name_copy;
+  entry.hash = htab_hash_string (linkage_name_copy);
   slot = ((struct demangled_name_entry **)
-	  htab_find_slot (per_bfd->demangled_names_hash.get (),
-			  &entry, INSERT));
+	  htab_find_slot_with_hash (per_bfd->demangled_names_hash.get (),
+				    &entry, entry.hash, INSERT));
+
+  bool auto_language = (gsymbol->language == language_unknown
+			|| gsymbol->language == language_auto);
+  gdb::unique_xmalloc_ptr<char> demangled_name;
+  bool demangled_p = false;
+
+  /* The demangled form of a name that is already in the hash table is
+     known, so there is no need to demangle it again; at most the
+     language of the symbol remains to be set.  */
+  if (*slot != NULL && auto_language)
+    {
+      if ((*slot)->language != language_unknown)
+	gsymbol->language = (*slot)->language;
+      else
+	{
+	  demangled_name.reset (symbol_find_demangled_name (gsymbol,
+							    linkage_name_copy));
+	  demangled_p = true;
+	  (*slot)->language = gsymbol->language;
+	}
+    }
 
   /* If this name is not in the hash table, add it.  */
   if (*slot == NULL
@@ -870,6 +902,10 @@ symbol_set_names (struct general_symbol_info *gsymbol,
       || (gsymbol->language == language_go
 	  && (*slot)->demangled[0] == '\0'))
     {
+      /* Set the symbol language.  */
+      if (!demangled_p)
+	demangled_name.reset (symbol_find_demangled_name (gsymbol,
+							  linkage_name_copy));
       int demangled_len = demangled_name ? strlen (demangled_name.get ()) : 0;
 
       /* Suppose we have demangled_name==NULL, copy_name==0, and
@@ -906,11 +942,13 @@ symbol_set_names (struct general_symbol_info *gsymbol,
 	  strcpy (mangled_ptr, linkage_name_copy);
 	  (*slot)->mangled = mangled_ptr;
 	}
+      (*slot)->hash = entry.hash;
 
       if (demangled_name != NULL)
 	strcpy ((*slot)->demangled, demangled_name.get());
       else
 	(*slot)->demangled[0] = '\0';
+      (*slot)->language = auto_language ? gsymbol->language : language_unknown;
     }
 
   gsymbol->name = (*slot)->mangled;
@@ -2852,6 +2890,97 @@ iterate_over_symbols (const struct block *block,
     }
 }
 
+/* Bring OBJFILE's compunit_map up to date with the compunits that
+   have been expanded since it was last updated.  */
+
+static void
+update_compunit_pc_map (struct objfile *objfile)
+{
+  compunit_pc_map &map = objfile->compunit_map;
+
+  if (map.head == objfile->compunit_symtabs)
+    return;
+
+  /* Compunits are only ever added to the front of the list, so the
+     new ones are those in front of the previous head.  */
+  std::vector<compunit_pc_map::entry> &entries = map.entries;
+  size_t old_size = entries.size ();
+
+  for (compunit_symtab *cust = objfile->compunit_symtabs;
+       cust != map.head;
+       cust = cust->next)
+    {
+      const struct block *b
+	= BLOCKVECTOR_BLOCK (COMPUNIT_BLOCKVECTOR (cust), GLOBAL_BLOCK);
+
+      entries.push_back ({BLOCK_START (b), BLOCK_END (b), 0, 0, cust});
+    }
+  map.head = objfile->compunit_symtabs;
+
+  /* The new entries were pushed starting with the most recently added
+     compunit.  */
+  size_t new_size = entries.size ();
+  for (size_t i = old_size; i < new_size; ++i)
+    entries[i].seq = old_size + new_size - 1 - i;
+
+  auto by_start = [] (const compunit_pc_map::entry &a,
+		      const compunit_pc_map::entry &b)
+    {
+      return a.start < b.start;
+    };
+  std::sort (entries.begin () + old_size, entries.end (), by_start);
+  std::inplace_merge (entries.begin (), entries.begin () + old_size,
+		      entries.end (), by_start);
+
+  CORE_ADDR max_end = 0;
+  for (compunit_pc_map::entry &e : entries)
+    {
+      max_end = std::max (max_end, e.end);
+      e.max_end = max_end;
+    }
+}
+
+/* Store in RESULT the expanded compunit symtabs of OBJFILE whose
+   global block contains PC, in the order in which they appear in
+   OBJFILE's compunit list.  */
+
+static void
+find_compunits_containing_pc (struct objfile *objfile, CORE_ADDR pc,
+			      std::vector<const compunit_pc_map::entry *>
+			        *result)
+{
+  update_compunit_pc_map (objfile);
+
+  const std::vector<compunit_pc_map::entry> &entries
+    = objfile->compunit_map.entries;
+
+  result->clear ();
+
+  /* Walk back from the last range starting at or before PC.  Once no
+     earlier range extends past PC, none of them can contain it.  */
+  auto iter = std::upper_bound (entries.begin (), entries.end (), pc,
+				[] (CORE_ADDR addr,
+				    const compunit_pc_map::entry &e)
+				{
+				  return addr < e.start;
+				});
+  while (iter != entries.begin ())
+    {
+      --iter;
+      if (iter->max_end <= pc)
+	break;
+      if (iter->end > pc)
+	result->push_back (&*iter);
+    }
+
+  std::sort (result->begin (), result->end (),
+	     [] (const compunit_pc_map::entry *a,
+		 const compunit_pc_map::entry *b)
+	     {
+	       return a->seq > b->seq;
+	     });
+}
+
 /* Find the compunit symtab associated with PC and SECTION.
    This will read in debug info as necessary.  */
 
@@ -2886,20 +3015,23 @@ find_pc_sect_compunit_symtab (CORE_ADDR pc, struct obj_section *section)
      It also happens for objfiles that have their functions reordered.
      For these, the symtab we are looking for is not necessarily read in.  */
 
+  std::vector<const compunit_pc_map::entry *> candidates;
+
   for (objfile *obj_file : current_program_space->objfiles ())
     {
-      for (compunit_symtab *cust : obj_file->compunits ())
+      find_compunits_containing_pc (obj_file, pc, &candidates);
+
+      for (const compunit_pc_map::entry *e : candidates)
 	{
+	  compunit_symtab *cust = e->cust;
 	  const struct block *b;
 	  const struct blockvector *bv;
 
 	  bv = COMPUNIT_BLOCKVECTOR (cust);
 	  b = BLOCKVECTOR_BLOCK (bv, GLOBAL_BLOCK);
 
-	  if (BLOCK_START (b) <= pc
-	      && BLOCK_END (b) > pc
-	      && (distance == 0
-		  || BLOCK_END (b) - BLOCK_START (b) < distance))
+	  if (distance == 0
+	      || BLOCK_END (b) - BLOCK_START (b) < distance)
 	    {
 	      /* For an objfile that has its functions reordered,
 		 find_pc_psymtab will find the proper partial symbol table
@@ -4293,6 +4425,38 @@ treg_matches_sym_type_name (const compiled_regex &treg,
 }
 
 
+/* If every name matched by the basic regular expression REGEXP must
+   start with the same literal string, return that string.  Otherwise,
+   or if the regexp does not start with an anchor, return an empty
+   string.  The result may be shorter than the longest such prefix.  */
+
+static std::string
+regexp_literal_prefix (const char *regexp)
+{
+  std::string prefix;
+
+  /* In GNU basic regexps "\|" is alternation, so "^foo\|bar" also
+     matches names that do not start with "foo".  */
+  if (*regexp != '^' || strstr (regexp, "\\|") != NULL)
+    return prefix;
+
+  for (const char *p = regexp + 1; *p != '\0'; ++p)
+    {
+      if (strchr (".[]()*+?{}|^$\\", *p) != NULL)
+	{
+	  /* These may make the preceding character optional.  A
+	     backslash starts an escape such as "\?" or "\{", so treat
+	     it the same way.  */
+	  if (strchr ("*+?{\\", *p) != NULL && !prefix.empty ())
+	    prefix.pop_back ();
+	  break;
+	}
+      prefix += *p;
+    }
+
+  return prefix;
+}
+
 /* Sort the symbols in RESULT and remove duplicates.  */
 
 static void
@@ -4345,6 +4509,7 @@ search_symbols (const char *regexp, enum search_domain kind,
   std::vector<symbol_search> result;
   gdb::optional<compiled_regex> preg;
   gdb::optional<compiled_regex> treg;
+  std::string regexp_prefix;
 
   gdb_assert (kind <= TYPES_DOMAIN);
 
@@ -4392,8 +4557,23 @@ search_symbols (const char *regexp, enum search_domain kind,
       int cflags = REG_NOSUB | (case_sensitivity == case_sensitive_off
 				? REG_ICASE : 0);
       preg.emplace (regexp, cflags, _("Invalid regexp"));
+
+      /* Running the regexp on every name is expensive.  If all the
+	 names it can match start with the same string, compare that
+	 first.  */
+      if (case_sensitivity != case_sensitive_off)
+	regexp_prefix = regexp_literal_prefix (regexp);
     }
 
+  auto name_matches = [&] (const char *name)
+    {
+      return (!preg.has_value ()
+	      || ((regexp_prefix.empty ()
+		   || strncmp (name, regexp_prefix.c_str (),
+			       regexp_prefix.size ()) == 0)
+		  && preg->exec (name, 0, NULL, 0) == 0));
+    };
+
   if (t_regexp != NULL)
     {
       int cflags = REG_NOSUB | (case_sensitivity == case_sensitive_off
@@ -4412,9 +4592,7 @@ search_symbols (const char *regexp, enum search_domain kind,
 			   lookup_name_info::match_any (),
 			   [&] (const char *symname)
 			   {
-			     return (!preg.has_value ()
-				     || preg->exec (symname,
-						    0, NULL, 0) == 0);
+			     return name_matches (symname);
 			   },
 			   NULL,
 			   kind);
@@ -4451,9 +4629,7 @@ search_symbols (const char *regexp, enum search_domain kind,
 		  || MSYMBOL_TYPE (msymbol) == ourtype3
 		  || MSYMBOL_TYPE (msymbol) == ourtype4)
 		{
-		  if (!preg.has_value ()
-		      || preg->exec (MSYMBOL_NATURAL_NAME (msymbol), 0,
-				     NULL, 0) == 0)
+		  if (name_matches (MSYMBOL_NATURAL_NAME (msymbol)))
 		    {
 		      /* Note: An important side-effect of these
 			 lookup functions is to expand the symbol
@@ -4484,46 +4660,50 @@ search_symbols (const char *regexp, enum search_domain kind,
 	      b = BLOCKVECTOR_BLOCK (bv, i);
 	      ALL_BLOCK_SYMBOLS (b, iter, sym)
 		{
-		  struct symtab *real_symtab = symbol_symtab (sym);
+		  struct symtab *real_symtab;
 
 		  QUIT;
 
+		  /* Check the class of the symbol and its name first,
+		     as they are the cheapest to check.  */
+		  if (!((kind == VARIABLES_DOMAIN
+			 && SYMBOL_CLASS (sym) != LOC_TYPEDEF
+			 && SYMBOL_CLASS (sym) != LOC_UNRESOLVED
+			 && SYMBOL_CLASS (sym) != LOC_BLOCK
+			 /* LOC_CONST can be used for more than just enums,
+			    e.g., c++ static const members.  We only want to
+			    skip enums here.  */
+			 && !(SYMBOL_CLASS (sym) == LOC_CONST
+			      && (TYPE_CODE (SYMBOL_TYPE (sym))
+				  == TYPE_CODE_ENUM)))
+			|| (kind == FUNCTIONS_DOMAIN
+			    && SYMBOL_CLASS (sym) == LOC_BLOCK)
+			|| (kind == TYPES_DOMAIN
+			    && SYMBOL_CLASS (sym) == LOC_TYPEDEF)))
+		    continue;
+
+		  if (!name_matches (SYMBOL_NATURAL_NAME (sym)))
+		    continue;
+
 		  /* Check first sole REAL_SYMTAB->FILENAME.  It does
 		     not need to be a substring of symtab_to_fullname as
 		     it may contain "./" etc.  */
-		  if ((file_matches (real_symtab->filename, files, nfiles, 0)
-		       || ((basenames_may_differ
-			    || file_matches (lbasename (real_symtab->filename),
-					     files, nfiles, 1))
-			   && file_matches (symtab_to_fullname (real_symtab),
-					    files, nfiles, 0)))
-		      && ((!preg.has_value ()
-			   || preg->exec (SYMBOL_NATURAL_NAME (sym), 0,
-					  NULL, 0) == 0)
-			  && ((kind == VARIABLES_DOMAIN
-			       && SYMBOL_CLASS (sym) != LOC_TYPEDEF
-			       && SYMBOL_CLASS (sym) != LOC_UNRESOLVED
-			       && SYMBOL_CLASS (sym) != LOC_BLOCK
-			       /* LOC_CONST can be used for more than
-				  just enums, e.g., c++ static const
-				  members.  We only want to skip enums
-				  here.  */
-			       && !(SYMBOL_CLASS (sym) == LOC_CONST
-				    && (TYPE_CODE (SYMBOL_TYPE (sym))
-					== TYPE_CODE_ENUM))
-			       && (!treg.has_value ()
-				   || treg_matches_sym_type_name (*treg, sym)))
-			      || (kind == FUNCTIONS_DOMAIN
-				  && SYMBOL_CLASS (sym) == LOC_BLOCK
-				  && (!treg.has_value ()
-				      || treg_matches_sym_type_name (*treg,
-								     sym)))
-			      || (kind == TYPES_DOMAIN
-				  && SYMBOL_CLASS (sym) == LOC_TYPEDEF))))
-		    {
-		      /* match */
-		      result.emplace_back (i, sym);
-		    }
+		  real_symtab = symbol_symtab (sym);
+		  if (!(file_matches (real_symtab->filename, files, nfiles, 0)
+			|| ((basenames_may_differ
+			     || file_matches (lbasename (real_symtab->filename),
+					      files, nfiles, 1))
+			    && file_matches (symtab_to_fullname (real_symtab),
+					     files, nfiles, 0))))
+		    continue;
+
+		  if (kind != TYPES_DOMAIN
+		      && treg.has_value ()
+		      && !treg_matches_sym_type_name (*treg, sym))
+		    continue;
+
+		  /* match */
+		  result.emplace_back (i, sym);
 		}
 	    }
 	}
@@ -4554,9 +4734,7 @@ search_symbols (const char *regexp, enum search_domain kind,
 		  || MSYMBOL_TYPE (msymbol) == ourtype3
 		  || MSYMBOL_TYPE (msymbol) == ourtype4)
 		{
-		  if (!preg.has_value ()
-		      || preg->exec (MSYMBOL_NATURAL_NAME (msymbol), 0,
-				     NULL, 0) == 0)
+		  if (name_matches (MSYMBOL_NATURAL_NAME (msymbol)))
 		    {
 		      /* For functions we can do a quick check of whether the
 			 symbol might be found via find_pc_symtab.  */
@@ -5290,7 +5468,14 @@ default_collect_symbol_completion_matches_break_on
     }
 
   /* Look through the partial symtabs for all symbols which begin by
-     matching SYM_TEXT.  Expand all CUs that you find to the list.  */
+     matching SYM_TEXT.  Expand all CUs that you find to the list.
+     When completing a struct, union or enum tag, only types can be
+     completions, so there is no need to expand a CU for anything else.
+     Linespec completion filters on the type of the symbol rather than
+     on its class, so it is not narrowed to FUNCTIONS_DOMAIN.  */
+  enum search_domain domain
+    = code != TYPE_CODE_UNDEF ? TYPES_DOMAIN : ALL_DOMAIN;
+
   expand_symtabs_matching (NULL,
 			   lookup_name,
 			   NULL,
@@ -5300,7 +5485,7 @@ default_collect_symbol_completion_matches_break_on
 						       tracker, mode, lookup_name,
 						       sym_text, word, code);
 			     },
-			   ALL_DOMAIN);
+			   domain);
 
   /* Search upwards from currently selected frame (so that we can
      complete on local vars).  Also catch fields of types defined in
@@ -5676,6 +5861,34 @@ set_main_name (const char *name, enum language lang)
     }
 }
 
+/* Look for the global symbol NAME in DOMAIN in the "partial" symbol
+   tables of the current program space, without expanding any symbol
+   table.  If found, set *SYMBOL_FOUND_P to true and return the language
+   of the symbol; otherwise set *SYMBOL_FOUND_P to false.  */
+
+static enum language
+find_quick_global_symbol_language (const char *name, const domain_enum domain,
+				   bool *symbol_found_p)
+{
+  for (objfile *objfile : current_program_space->objfiles ())
+    {
+      if (objfile->sf != NULL
+	  && objfile->sf->qf != NULL
+	  && objfile->sf->qf->lookup_global_symbol_language != NULL)
+	{
+	  enum language lang
+	    = (objfile->sf->qf->lookup_global_symbol_language
+	       (objfile, name, domain, symbol_found_p));
+
+	  if (*symbol_found_p)
+	    return lang;
+	}
+    }
+
+  *symbol_found_p = false;
+  return language_unknown;
+}
+
 /* Deduce the name of the main procedure, and set NAME_OF_MAIN
    accordingly.  */
 
@@ -5745,8 +5958,13 @@ find_main_name (void)
     }
 
   /* The languages above didn't identify the name of the main procedure.
-     Fallback to "main".  */
-  set_main_name ("main", language_unknown);
+     Fallback to "main".  Its language can usually be found in the
+     partial symbols or the index, which avoids expanding the full
+     symbol table of the unit defining it just for that.  */
+  bool symbol_found_p;
+  enum language lang
+    = find_quick_global_symbol_language ("main", VAR_DOMAIN, &symbol_found_p);
+  set_main_name ("main", symbol_found_p ? lang : language_unknown);
 }
 
 char *
@@ -669,6 +669,10 @@ struct minimal_symbol : public general_symbol_info
      the object file format may not carry that piece of information.  */
   unsigned int has_size : 1;
 
+  /* Nonzero once the demangled name and language of this symbol have
+     been computed; see minimal_symbol_reader::install.  */
+  unsigned int name_set : 1;
+
   /* Minimal symbols with the same hash key are kept on a linked
      list.  This is the link.  */
 
@@ -2088,7 +2092,8 @@ bool iterate_over_some_symtabs (const char *name,
 				gdb::function_view<bool (symtab *)> callback);
 
 void iterate_over_symtabs (const char *name,
-			   gdb::function_view<bool (symtab *)> callback);
+			   gdb::function_view<bool (symtab *)> callback,
+			   struct objfile *only_objfile = NULL);
 
 
 std::vector<CORE_ADDR> find_pcs_for_symtab_line
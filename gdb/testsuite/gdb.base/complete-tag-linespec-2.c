@@ -0,0 +1,43 @@
+/* This testcase is part of GDB, the GNU debugger.
+
+   Copyright 2019 Free Software Foundation, Inc.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+
+struct ctl_struct
+{
+  int s;
+};
+
+union ctl_union
+{
+  int i;
+  char c;
+};
+
+enum ctl_enum
+{
+  CTL_ENUM_A,
+  CTL_ENUM_B
+};
+
+struct ctl_struct s_var;
+union ctl_union u_var;
+enum ctl_enum e_var;
+
+int
+ctl_function (int arg)
+{
+  return arg + s_var.s + u_var.i + e_var;
+}
@@ -15,6 +15,12 @@
    You should have received a copy of the GNU General Public License
    along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
 
+/* Built a second time with SECOND_BINARY defined, to get an executable
+   with another build id.  */
+#ifdef SECOND_BINARY
+int second_binary;
+#endif
+
 int
 main ()
 {
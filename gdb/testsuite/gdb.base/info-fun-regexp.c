@@ -0,0 +1,53 @@
+/* This testcase is part of GDB, the GNU debugger.
+
+   Copyright 2019 Free Software Foundation, Inc.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+
+int
+rx_foo_one (void)
+{
+  return 1;
+}
+
+int
+rx_foo_two (void)
+{
+  return 2;
+}
+
+int
+rx_fo_x (void)
+{
+  return 3;
+}
+
+int
+rx_fooo_x (void)
+{
+  return 4;
+}
+
+int
+other_rx_bar (void)
+{
+  return 5;
+}
+
+int
+main (void)
+{
+  return (rx_foo_one () + rx_foo_two () + rx_fo_x () + rx_fooo_x ()
+	  + other_rx_bar ());
+}
@@ -0,0 +1,55 @@
+/* This testcase is part of GDB, the GNU debugger.
+
+   Copyright 2019 Free Software Foundation, Inc.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+
+#include <dlfcn.h>
+#include <stdlib.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+void
+child_function (void)
+{
+}
+
+int
+main (void)
+{
+  void *handle;
+  void (*lib_function) (void);
+  pid_t pid;
+
+  handle = dlopen (SHLIB_NAME, RTLD_LAZY);
+  if (handle == NULL)
+    abort ();
+
+  lib_function = (void (*) (void)) dlsym (handle, "lib_function");
+  if (lib_function == NULL)
+    abort ();
+
+  pid = fork ();
+  if (pid == 0)
+    {
+      child_function ();
+      lib_function ();
+      _exit (0);
+    }
+
+  lib_function ();
+  waitpid (pid, NULL, 0);
+  return 0;
+}
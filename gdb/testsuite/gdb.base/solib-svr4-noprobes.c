@@ -0,0 +1,68 @@
+/* This testcase is part of GDB, the GNU debugger.
+
+   Copyright 2019 Free Software Foundation, Inc.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+
+#include <dlfcn.h>
+#include <assert.h>
+#include <stddef.h>
+
+void
+stop (void)
+{
+}
+
+static void *
+load (const char *name)
+{
+  void *handle = dlopen (name, RTLD_NOW);
+
+  assert (handle != NULL);
+  return handle;
+}
+
+int
+main (void)
+{
+  void *handle1, *handle2, *handle3;
+
+  handle1 = load (SHLIB1_NAME);
+  handle2 = load (SHLIB2_NAME);
+  handle3 = load (SHLIB3_NAME);
+  stop ();
+
+  /* Remove a library from the middle of the list.  */
+  dlclose (handle2);
+  stop ();
+
+  /* Load it again; it is now at the end of the list.  */
+  handle2 = load (SHLIB2_NAME);
+  stop ();
+
+  dlclose (handle1);
+  dlclose (handle3);
+  stop ();
+
+  handle3 = load (SHLIB3_NAME);
+  handle1 = load (SHLIB1_NAME);
+  stop ();
+
+  dlclose (handle1);
+  dlclose (handle2);
+  dlclose (handle3);
+  stop ();
+
+  return 0;
+}
@@ -0,0 +1,69 @@
+/* This testcase is part of GDB, the GNU debugger.
+
+   Copyright (C) 2019 Free Software Foundation, Inc.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+
+/* This file is compiled once per compilation unit, with CU set to the
+   number of the unit and CU_COUNT to the total number of units.  The
+   function of each unit calls the function of the next one, so that
+   the stack at break_here has one frame per compilation unit.  */
+
+#define CONCAT_1(a, b) a ## b
+#define CONCAT(a, b) CONCAT_1 (a, b)
+#define CU_FUNC(n) CONCAT (cu_func_, n)
+
+extern volatile int global_var;
+extern void break_here (void);
+
+#if CU + 1 < CU_COUNT
+extern void CU_FUNC (CU_NEXT) (int depth);
+#endif
+
+static int
+CONCAT (cu_helper_, CU) (int depth)
+{
+  return depth + global_var;
+}
+
+void
+CU_FUNC (CU) (int depth)
+{
+  global_var = CONCAT (cu_helper_, CU) (depth);
+#if CU + 1 < CU_COUNT
+  CU_FUNC (CU_NEXT) (depth + 1);
+#else
+  break_here ();
+#endif
+  global_var++;
+}
+
+#if CU == 0
+
+volatile int global_var;
+
+void
+break_here (void)
+{
+  global_var++;
+}
+
+int
+main (void)
+{
+  cu_func_0 (0);
+  return 0;
+}
+
+#endif
@@ -0,0 +1,39 @@
+# Copyright (C) 2019 Free Software Foundation, Inc.
+
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+# This test case is to test the speed of GDB when it does a backtrace
+# through frames that are each in a different compilation unit.
+
+from perftest import perftest
+
+class BacktraceCus(perftest.TestCaseWithBasicMeasurements):
+    def __init__(self):
+        super(BacktraceCus, self).__init__("backtrace-cus")
+
+    def _test(self, count):
+        for _ in range(0, count):
+            # Flush the frame cache, so that each backtrace has to map
+            # every PC to its symbol table again.
+            gdb.execute("flushregs", False, True)
+            gdb.execute("bt", False, True)
+
+    def warm_up(self):
+        # Expand the symbol tables of all the frames.
+        gdb.execute("bt", False, True)
+
+    def execute_test(self):
+        for i in range(1, 4):
+            func = lambda: self._test(i * 5)
+            self.measure.measure(func, i)
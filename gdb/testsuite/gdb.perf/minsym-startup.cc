@@ -0,0 +1,86 @@
+/* This testcase is part of GDB, the GNU debugger.
+
+   Copyright (C) 2019 Free Software Foundation, Inc.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+
+/* Instantiate NCLASSES * NMETHODS distinct C++ functions, so that the
+   program has that many mangled minimal symbols.  */
+
+#ifndef NCLASSES
+#define NCLASSES 100
+#endif
+
+#define NMETHODS 100
+
+namespace minsym_startup
+{
+  template<int C, int M>
+  struct klass
+  {
+    static int __attribute__ ((noinline))
+    method (const char *str, int val)
+    {
+      return str[0] + val + C * M;
+    }
+  };
+
+  template<int C, int M>
+  struct methods
+  {
+    static int
+    call (const char *str)
+    {
+      return (klass<C, M>::method (str, M)
+	      + methods<C, M - 1>::call (str));
+    }
+  };
+
+  template<int C>
+  struct methods<C, 0>
+  {
+    static int
+    call (const char *)
+    {
+      return 0;
+    }
+  };
+
+  template<int C>
+  struct classes
+  {
+    static int
+    call (const char *str)
+    {
+      return (methods<C, NMETHODS>::call (str)
+	      + classes<C - 1>::call (str));
+    }
+  };
+
+  template<>
+  struct classes<0>
+  {
+    static int
+    call (const char *)
+    {
+      return 0;
+    }
+  };
+}
+
+int
+main (void)
+{
+  return minsym_startup::classes<NCLASSES>::call ("") != 0 ? 0 : 1;
+}
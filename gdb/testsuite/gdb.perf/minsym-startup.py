@@ -0,0 +1,38 @@
+# Copyright (C) 2019 Free Software Foundation, Inc.
+
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+# This test case is to test the speed of GDB when it reads the minimal
+# symbols of a program at startup.
+
+from perftest import perftest
+from perftest import utils
+
+class MinsymStartup(perftest.TestCaseWithBasicMeasurements):
+    def __init__(self, binfile, count):
+        super(MinsymStartup, self).__init__("minsym-startup")
+        self.binfile = binfile
+        self.count = count
+
+    def _test(self):
+        for _ in range(0, self.count):
+            utils.select_file(None)
+            utils.select_file(self.binfile)
+
+    def warm_up(self):
+        utils.select_file(self.binfile)
+
+    def execute_test(self):
+        for i in range(1, 4):
+            self.measure.measure(self._test, i)
@@ -308,6 +308,18 @@ enum output_type
 #define bfd_link_executable(info)  (bfd_link_pde (info) || bfd_link_pie (info))
 #define bfd_link_pic(info)	   (bfd_link_dll (info) || bfd_link_pie (info))
 
+/* Statistics BFD gathers during a link for the linker's --stats
+   option.  */
+
+struct bfd_link_stats
+{
+  /* Run time spent finalizing ELF string tables, in microseconds.  */
+  long strtab_time;
+
+  /* Bytes saved by storing strings as suffixes of other strings.  */
+  bfd_size_type strtab_saved;
+};
+
 /* This structure holds all the information needed to communicate
    between BFD and the linker when doing a link.  */
 
@@ -432,6 +444,10 @@ struct bfd_link_info
   /* TRUE if the new ELF dynamic tags are enabled. */
   unsigned int new_dtags: 1;
 
+  /* TRUE if relative relocations should be packed into a DT_RELR
+     section.  */
+  unsigned int enable_dt_relr: 1;
+
   /* FALSE if .eh_frame unwind info should be generated for PLT and other
      linker created sections, TRUE if it should be omitted.  */
   unsigned int no_ld_generated_unwind_info: 1;
@@ -628,6 +644,9 @@ struct bfd_link_info
 
   /* The version information.  */
   struct bfd_elf_version_tree *version_info;
+
+  /* Where to accumulate statistics for --stats, or NULL.  */
+  struct bfd_link_stats *stats;
 };
 
 /* This structures holds a set of callback functions.  These are called
@@ -0,0 +1,15 @@
+PARSE_AND_LIST_OPTIONS_DT_RELR='
+  fprintf (file, _("\
+  -z pack-relative-relocs     Pack relative relocations into DT_RELR\n"));
+  fprintf (file, _("\
+  -z nopack-relative-relocs   Do not pack relative relocations (default)\n"));
+'
+PARSE_AND_LIST_ARGS_CASE_Z_DT_RELR='
+      else if (strcmp (optarg, "pack-relative-relocs") == 0)
+	link_info.enable_dt_relr = TRUE;
+      else if (strcmp (optarg, "nopack-relative-relocs") == 0)
+	link_info.enable_dt_relr = FALSE;
+'
+
+PARSE_AND_LIST_OPTIONS="$PARSE_AND_LIST_OPTIONS $PARSE_AND_LIST_OPTIONS_DT_RELR"
+PARSE_AND_LIST_ARGS_CASE_Z="$PARSE_AND_LIST_ARGS_CASE_Z $PARSE_AND_LIST_ARGS_CASE_Z_DT_RELR"
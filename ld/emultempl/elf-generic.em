@@ -44,6 +44,8 @@ gld${EMULATION_NAME}_map_segments (bfd_boolean need_layout)
 	     previous linker generated program headers.  */
 	  if (lang_phdr_list == NULL)
 	    elf_seg_map (link_info.output_bfd) = NULL;
+	  if (!bfd_elf_size_relative_relocs (&link_info, &need_layout))
+	    einfo (_("%F%P: failed to size relative relocations: %E\n"));
 	  if (!_bfd_elf_map_sections_to_segments (link_info.output_bfd,
 						  &link_info))
 	    einfo (_("%F%P: map sections to segments failed: %E\n"));
@@ -155,6 +155,9 @@ static bfd_assert_handler_type default_bfd_assert_handler;
 static bfd_error_handler_type default_bfd_error_handler;
 
 struct bfd_link_info link_info;
+
+/* Statistics gathered by BFD for --stats.  */
+static struct bfd_link_stats link_stats;
 
 static void
 ld_cleanup (void)
@@ -317,6 +320,9 @@ main (int argc, char **argv)
   if (config.hash_table_size != 0)
     bfd_hash_set_default_size (config.hash_table_size);
 
+  if (config.stats)
+    link_info.stats = &link_stats;
+
 #ifdef ENABLE_PLUGINS
   /* Now all the plugin arguments have been gathered, we can load them.  */
   plugin_load_plugins ();
@@ -548,6 +554,11 @@ main (int argc, char **argv)
       fflush (stdout);
       fprintf (stderr, _("%s: total time in link: %ld.%06ld\n"),
 	       program_name, run_time / 1000000, run_time % 1000000);
+      fprintf (stderr, _("%s: string table merging: %ld.%06ld,"
+			 " %" BFD_VMA_FMT "u bytes saved\n"),
+	       program_name, link_stats.strtab_time / 1000000,
+	       link_stats.strtab_time % 1000000,
+	       (bfd_vma) link_stats.strtab_saved);
       fflush (stderr);
     }
 
@@ -476,6 +476,7 @@ cat >> ldscripts/dyntmp.$$ <<EOF
       ${IREL_IN_PLT+${RELOCATING+${CREATE_PIC-PROVIDE_HIDDEN (${USER_LABEL_PREFIX}__rela_iplt_end = .);}}}
     }
   ${OTHER_PLT_RELOC_SECTIONS}
+  .relr.dyn     ${RELOCATING-0} : { *(.relr.dyn) }
 EOF
 
 emit_dyn()
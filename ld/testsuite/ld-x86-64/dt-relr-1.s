@@ -0,0 +1,18 @@
+	.data
+	.p2align 3
+	.globl	sym
+	.type	sym, @object
+sym:
+	.quad	local
+	.quad	local + 8
+	.quad	hidden
+	.quad	sym
+	.byte	0
+	.quad	local
+	.p2align 3
+local:
+	.quad	0
+	.globl	hidden
+	.hidden	hidden
+hidden:
+	.quad	0